@@ -36,28 +36,45 @@ void FVoxelBlockSparseQueryData::Initialize(const FVoxelIntVectorBuffer& Positio
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void FVoxelBlockChunkQueryData::Initialize(const FVoxelIntBox& Bounds)
+FVoxelIntVectorBuffer FVoxelBlockChunkQueryData::GetBlockPositions() const
 {
-	VOXEL_FUNCTION_COUNTER();
-	VOXEL_USE_NAMESPACE(MetaGraph);
+	VOXEL_SCOPE_LOCK(CriticalSection);
 
-	PrivateBounds = Bounds;
+	if (CachedPositions_RequiresLock)
+	{
+		return CachedPositions_RequiresLock.GetValue();
+	}
 
-	const FIntVector Size = PrivateBounds.Size();
+	VOXEL_FUNCTION_COUNTER();
+	VOXEL_USE_NAMESPACE(MetaGraph);
 
-	TVoxelArray<int32> PositionsX = FVoxelInt32Buffer::Allocate(Size.X * Size.Y * Size.Z);
-	TVoxelArray<int32> PositionsY = FVoxelInt32Buffer::Allocate(Size.X * Size.Y * Size.Z);
-	TVoxelArray<int32> PositionsZ = FVoxelInt32Buffer::Allocate(Size.X * Size.Y * Size.Z);
+	TVoxelArray<int32> PositionsX = FVoxelInt32Buffer::Allocate(Num());
+	TVoxelArray<int32> PositionsY = FVoxelInt32Buffer::Allocate(Num());
+	TVoxelArray<int32> PositionsZ = FVoxelInt32Buffer::Allocate(Num());
 
 	FRuntimeUtilities::WriteIntPositions_Unpacked(
 		PositionsX,
 		PositionsY,
 		PositionsZ,
 		PrivateBounds.Min,
-		1,
-		Size);
+		PrivateStep,
+		PrivateSize);
 
-	CachedPositions = FVoxelIntVectorBuffer::MakeCpu(PositionsX, PositionsY, PositionsZ);
+	CachedPositions_RequiresLock = FVoxelIntVectorBuffer::MakeCpu(PositionsX, PositionsY, PositionsZ);
+	return CachedPositions_RequiresLock.GetValue();
+}
+
+void FVoxelBlockChunkQueryData::Initialize(const FVoxelIntBox& Bounds, const int32 Step)
+{
+	check(Step >= 1);
+	ensure(Bounds.Size() % Step == 0);
+
+	PrivateBounds = Bounds;
+	PrivateStep = Step;
+	PrivateSize = PrivateBounds.Size() / Step;
+
+	VOXEL_SCOPE_LOCK(CriticalSection);
+	CachedPositions_RequiresLock.Reset();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -155,6 +172,59 @@ void FVoxelBlockSurface::GetFaceData(
 	}
 }
 
+FVoxelBlockData FVoxelBlockSurface::GetDominantBlock(TConstVoxelArrayView<FVoxelBlockData> Samples, const bool bIsNeighbor)
+{
+	check(Samples.Num() > 0);
+
+	if (bIsNeighbor)
+	{
+		// The neighbor might be rendered at a higher resolution: only let it hide our faces if it's fully opaque,
+		// otherwise we would leave holes at LOD transitions
+		for (const FVoxelBlockData& Sample : Samples)
+		{
+			if (Sample.IsAir())
+			{
+				return Sample;
+			}
+		}
+	}
+
+	// Cells are solid as soon as any of their samples is, so that lower LODs always
+	// fully cover higher LODs and no hole can appear on the high resolution side either
+	int32 BestIndex = -1;
+	int32 BestCount = 0;
+	for (int32 Index = 0; Index < Samples.Num(); Index++)
+	{
+		const FVoxelBlockData Sample = Samples[Index];
+		if (Sample.IsAir())
+		{
+			continue;
+		}
+
+		int32 Count = 0;
+		for (const FVoxelBlockData& OtherSample : Samples)
+		{
+			if (OtherSample.GetId() == Sample.GetId())
+			{
+				Count++;
+			}
+		}
+
+		if (Count > BestCount)
+		{
+			BestIndex = Index;
+			BestCount = Count;
+		}
+	}
+
+	if (BestIndex == -1)
+	{
+		return Samples[0];
+	}
+
+	return Samples[BestIndex];
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -163,10 +233,6 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelBlockSurface_GenerateSurface, Surface)
 {
 	FindVoxelQueryData(FVoxelBoundsQueryData, BoundsQueryData);
 	FindVoxelQueryData(FVoxelLODQueryData, LODQueryData);
-	if (LODQueryData->LOD != 0)
-	{
-		return {};
-	}
 
 	const TValue<float> BlockSize = Get(BlockSizePin, Query);
 
@@ -178,12 +244,27 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelBlockSurface_GenerateSurface, Surface)
 			return {};
 		}
 
+		const int32 LOD = LODQueryData->LOD;
+		if (LOD < 0 || LOD > 20)
+		{
+			VOXEL_MESSAGE(Error, "{0}: invalid LOD ({1})", this, LOD);
+			return {};
+		}
+
+		// Each cell is 2^LOD blocks wide
+		const int32 Step = 1 << LOD;
+		const float CellSize = BlockSize * Step;
+
 		const FVoxelBox Bounds = BoundsQueryData->Bounds;
-		const FIntVector Size = FVoxelUtilities::CeilToInt(Bounds.Size() / BlockSize);
+		const FIntVector Size = FVoxelUtilities::CeilToInt(Bounds.Size() / CellSize);
 		const FIntVector SizeWithNeighbors = Size + 2;
-		const FIntVector Start = FVoxelUtilities::FloorToInt(Bounds.Min / BlockSize) - 1;
+		const FIntVector Start = FVoxelUtilities::FloorToInt(Bounds.Min / CellSize) - 1;
 
-		const int64 NumQueriedVoxels = int64(SizeWithNeighbors.X) * int64(SizeWithNeighbors.Y) * int64(SizeWithNeighbors.Z);
+		// Above LOD 0, every cell is sampled 2x2x2 times to find its dominant block
+		const int32 NumSamplesPerCell = LOD == 0 ? 1 : 2;
+		const FIntVector NumSamples = SizeWithNeighbors * NumSamplesPerCell;
+
+		const int64 NumQueriedVoxels = int64(NumSamples.X) * int64(NumSamples.Y) * int64(NumSamples.Z);
 		if (NumQueriedVoxels >= 32 * 1024 * 1024)
 		{
 			VOXEL_MESSAGE(Error, "{0}: too many voxels queried ({1})", this, NumQueriedVoxels);
@@ -191,14 +272,18 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelBlockSurface_GenerateSurface, Surface)
 		}
 
 		FVoxelQuery BlockQuery = Query;
-		BlockQuery.Add<FVoxelBlockChunkQueryData>().Initialize(FVoxelIntBox(Start, Start + SizeWithNeighbors));
+		BlockQuery.Add<FVoxelBlockChunkQueryData>().Initialize(
+			FVoxelIntBox(Start * Step, (Start + SizeWithNeighbors) * Step),
+			Step / NumSamplesPerCell);
 		const TValue<TBufferView<FVoxelBlockData>> Blocks = GetBufferView(BlockPin, BlockQuery);
 
-		return VOXEL_ON_COMPLETE(AsyncThread, BlockSize, Blocks, Size, SizeWithNeighbors)
+		return VOXEL_ON_COMPLETE(AsyncThread, LOD, BlockSize, Blocks, Size, SizeWithNeighbors, NumSamples)
 		{
 			const TSharedRef<FVoxelBlockSurface> Surface = MakeShared<FVoxelBlockSurface>();
+			Surface->LOD = LOD;
 			Surface->BlockSize = BlockSize;
 
+			const auto FindFaces = [&](const auto& Cells)
 			{
 				VOXEL_SCOPE_COUNTER("FindFaces");
 
@@ -215,7 +300,7 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelBlockSurface_GenerateSurface, Surface)
 								Index++;
 							};
 
-							const FVoxelBlockData BlockData = Blocks[Index];
+							const FVoxelBlockData BlockData = Cells[Index];
 							if (BlockData.IsAir())
 							{
 								continue;
@@ -225,7 +310,7 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelBlockSurface_GenerateSurface, Surface)
 							{ \
 								const int32 OtherIndex = Index + InX + InY * SizeWithNeighbors.X + InZ * SizeWithNeighbors.X * SizeWithNeighbors.Y; \
 								checkVoxelSlow(OtherIndex == FVoxelUtilities::Get3DIndex<int32>(SizeWithNeighbors, X + InX, Y + InY, Z + InZ, -1)); \
-								const FVoxelBlockData OtherBlockData = Blocks[OtherIndex]; \
+								const FVoxelBlockData OtherBlockData = Cells[OtherIndex]; \
 								\
 								if (OtherBlockData.IsAir()) \
 								{ \
@@ -259,8 +344,50 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelBlockSurface_GenerateSurface, Surface)
 						}
 					}
 				}
+			};
+
+			if (LOD == 0)
+			{
+				FindFaces(Blocks);
+				return Surface;
+			}
+
+			TVoxelArray<FVoxelBlockData> Cells;
+			FVoxelUtilities::SetNumFast(Cells, SizeWithNeighbors);
+			{
+				VOXEL_SCOPE_COUNTER("Downsample");
+
+				int32 CellIndex = 0;
+				for (int32 Z = 0; Z < SizeWithNeighbors.Z; Z++)
+				{
+					for (int32 Y = 0; Y < SizeWithNeighbors.Y; Y++)
+					{
+						for (int32 X = 0; X < SizeWithNeighbors.X; X++)
+						{
+							checkVoxelSlow(CellIndex == FVoxelUtilities::Get3DIndex<int32>(SizeWithNeighbors, X, Y, Z));
+
+							TVoxelStaticArray<FVoxelBlockData, 8> Samples{ NoInit };
+							for (int32 SampleIndex = 0; SampleIndex < 8; SampleIndex++)
+							{
+								Samples[SampleIndex] = Blocks[FVoxelUtilities::Get3DIndex<int32>(
+									NumSamples,
+									2 * X + bool(SampleIndex & 0x1),
+									2 * Y + bool(SampleIndex & 0x2),
+									2 * Z + bool(SampleIndex & 0x4))];
+							}
+
+							const bool bIsNeighbor =
+								X == 0 || X == SizeWithNeighbors.X - 1 ||
+								Y == 0 || Y == SizeWithNeighbors.Y - 1 ||
+								Z == 0 || Z == SizeWithNeighbors.Z - 1;
+
+							Cells[CellIndex++] = FVoxelBlockSurface::GetDominantBlock(Samples, bIsNeighbor);
+						}
+					}
+				}
 			}
 
+			FindFaces(Cells);
 			return Surface;
 		};
 	};
@@ -30,6 +30,11 @@ struct VOXELBLOCK_API FVoxelBlockDataPinType : public FVoxelExposedPinType
 		}
 		return MakeSharedCopy(BlockRegistry.GetBlockData(BlockId));
 	}
+
+	virtual bool DependsOnRuntime() const override
+	{
+		return true;
+	}
 };
 
 DECLARE_VOXEL_TERMINAL_BUFFER(FVoxelBlockDataBufferView, FVoxelBlockDataBuffer, FVoxelBlockData, PF_R32_UINT);
@@ -111,24 +116,41 @@ public:
 	{
 		return PrivateBounds;
 	}
-	virtual FVoxelIntVectorBuffer GetBlockPositions() const override
+	FORCEINLINE int32 Step() const
 	{
-		return CachedPositions;
+		return PrivateStep;
 	}
+	FORCEINLINE const FIntVector& Size() const
+	{
+		return PrivateSize;
+	}
+	FORCEINLINE int32 Num() const
+	{
+		return PrivateSize.X * PrivateSize.Y * PrivateSize.Z;
+	}
+	// Will allocate the positions buffer the first time it's called
+	virtual FVoxelIntVectorBuffer GetBlockPositions() const override;
 
-	void Initialize(const FVoxelIntBox& Bounds);
+	// Bounds must be a multiple of Step, positions will be Bounds.Min + Index * Step
+	void Initialize(const FVoxelIntBox& Bounds, int32 Step = 1);
 
 private:
 	FVoxelIntBox PrivateBounds;
-	FVoxelIntVectorBuffer CachedPositions;
+	int32 PrivateStep = 1;
+	FIntVector PrivateSize = FIntVector::ZeroValue;
+
+	mutable FVoxelCriticalSection CriticalSection;
+	mutable TOptional<FVoxelIntVectorBuffer> CachedPositions_RequiresLock;
 	
 	uint64 GetHash() const
 	{
-		return FVoxelUtilities::MurmurHash(PrivateBounds);
+		return FVoxelUtilities::MurmurHashMulti(PrivateBounds, PrivateStep);
 	}
 	bool Identical(const FVoxelBlockChunkQueryData& Other) const
 	{
-		return PrivateBounds == Other.PrivateBounds;
+		return
+			PrivateBounds == Other.PrivateBounds &&
+			PrivateStep == Other.PrivateStep;
 	}
 };
 
@@ -142,6 +164,7 @@ struct VOXELBLOCK_API FVoxelBlockSurface : public FVoxelSurface
 	GENERATED_BODY()
 	GENERATED_VIRTUAL_STRUCT_BODY()
 
+	int32 LOD = 0;
 	float BlockSize = 0.f;
 
 	struct FFaceMesh
@@ -153,9 +176,11 @@ struct VOXELBLOCK_API FVoxelBlockSurface : public FVoxelSurface
 
 	int32 GetNumFaces() const;
 
+	// Positions are in LOD cells, each cell spanning 2^LOD blocks
 	FORCEINLINE FVector3f GetVertexPosition(int32 Direction, int32 FaceIndex, const FVector3f& CornerPosition) const
 	{
-		const FVector3f VertexPosition = CornerPosition + FVector3f(FaceMeshes[Direction].Positions[FaceIndex]) - FVector3f(0.5f);
+		const float Step = 1 << LOD;
+		const FVector3f VertexPosition = (CornerPosition + FVector3f(FaceMeshes[Direction].Positions[FaceIndex])) * Step - FVector3f(0.5f);
 		return VertexPosition * BlockSize;
 	}
 
@@ -164,6 +189,10 @@ struct VOXELBLOCK_API FVoxelBlockSurface : public FVoxelSurface
 		TVoxelStaticArray<FVector3f, 4>& OutPositions,
 		FVector3f& OutNormal,
 		FVector3f& OutTangent);
+
+	// Used to downsample a LOD cell: returns the most common non-air block among Samples
+	// bIsNeighbor: whether the cell is outside of the chunk, in which case it's air unless fully solid
+	static FVoxelBlockData GetDominantBlock(TConstVoxelArrayView<FVoxelBlockData> Samples, bool bIsNeighbor);
 };
 
 USTRUCT(Category = "Mesh|Block")
@@ -59,33 +59,28 @@ void UVoxelHeightmapCanvasAsset::PaintCircle(
 		return;
 	}
 
-	const TVoxelArrayView<float> DataView = Data->GetData();
-
-	const FIntPoint Min = FVoxelUtilities::Clamp(FVoxelUtilities::FloorToInt(Center - Radius), FIntPoint::ZeroValue, Size - 1);
-	const FIntPoint Max = FVoxelUtilities::Clamp(FVoxelUtilities::CeilToInt(Center + Radius), FIntPoint::ZeroValue, Size - 1);
+	const FIntPoint Min = FVoxelUtilities::FloorToInt(Center - Radius);
+	const FIntPoint Max = FVoxelUtilities::CeilToInt(Center + Radius);
 
 	FVoxelOptionalBox2D Bounds;
-	for (int32 X = Min.X; X <= Max.X; X++)
+	Data->Edit(Min, Max, [&](const int32 X, const int32 Y, float& Height)
 	{
-		for (int32 Y = Min.Y; Y <= Max.Y; Y++)
-		{
-			const float Distance = FVector2f::Distance(FVector2f(X, Y), FVector2f(Center));
-			const float FinalStrength =
-				FMath::Clamp(Strength, 0.f, 1.f) *
-				FVoxelUtilities::GetFalloff(FalloffType, Distance, Radius, Falloff);
+		const float Distance = FVector2f::Distance(FVector2f(X, Y), FVector2f(Center));
+		const float FinalStrength =
+			FMath::Clamp(Strength, 0.f, 1.f) *
+			FVoxelUtilities::GetFalloff(FalloffType, Distance, Radius, Falloff);
 
-			if (FinalStrength == 0.f)
-			{
-				continue;
-			}
+		if (FinalStrength == 0.f)
+		{
+			return false;
+		}
 
-			Bounds += FVector2D(X, Y);
+		Bounds += FVector2D(X, Y);
 
-			const int32 Index = FVoxelUtilities::Get2DIndex<int32>(Size, X, Y);
-			const float NewValue = FMath::Lerp(DataView[Index], Value, FinalStrength);
-			ApplyBehavior(DataView[Index], NewValue, Behavior);
-		}
-	}
+		const float NewValue = FMath::Lerp(Height, Value, FinalStrength);
+		ApplyBehavior(Height, NewValue, Behavior);
+		return true;
+	});
 
 	if (Bounds.IsValid())
 	{
@@ -107,19 +102,14 @@ void UVoxelHeightmapCanvasAsset::PaintSquare(
 		return;
 	}
 
-	const TVoxelArrayView<float> DataView = Data->GetData();
-	
 	const FIntPoint Min = FVoxelUtilities::Clamp(FVoxelUtilities::FloorToInt(Center - Extent), FIntPoint::ZeroValue, Size - 1);
 	const FIntPoint Max = FVoxelUtilities::Clamp(FVoxelUtilities::CeilToInt(Center + Extent), FIntPoint::ZeroValue, Size - 1);
-	
-	for (int32 X = Min.X; X <= Max.X; X++)
+
+	Data->Edit(Min, Max, [&](int32, int32, float& Height)
 	{
-		for (int32 Y = Min.Y; Y <= Max.Y; Y++)
-		{
-			const int32 Index = FVoxelUtilities::Get2DIndex<int32>(Size, X, Y);
-			ApplyBehavior(DataView[Index], Value, Behavior);
-		}
-	}
+		ApplyBehavior(Height, Value, Behavior);
+		return true;
+	});
 
 	Update(FVoxelBox2D(FVector2D(Min), FVector2D(Max)));
 }
@@ -140,40 +130,35 @@ void UVoxelHeightmapCanvasAsset::PaintRamp(
 		return;
 	}
 
-	const TVoxelArrayView<float> DataView = Data->GetData();
-	
-	const FIntPoint Min = FVoxelUtilities::Clamp(FVoxelUtilities::FloorToInt(FVoxelUtilities::ComponentMin(Start, End) - Width), FIntPoint::ZeroValue, Size - 1);
-	const FIntPoint Max = FVoxelUtilities::Clamp(FVoxelUtilities::CeilToInt(FVoxelUtilities::ComponentMax(Start, End) + Width), FIntPoint::ZeroValue, Size - 1);
+	const FIntPoint Min = FVoxelUtilities::FloorToInt(FVoxelUtilities::ComponentMin(Start, End) - Width);
+	const FIntPoint Max = FVoxelUtilities::CeilToInt(FVoxelUtilities::ComponentMax(Start, End) + Width);
 
 	const FVector2f Direction = FVector2f((End - Start).GetSafeNormal());
 	const float Length = (End - Start).Size();
 
 	FVoxelOptionalBox2D Bounds;
-	for (int32 X = Min.X; X <= Max.X; X++)
+	Data->Edit(Min, Max, [&](const int32 X, const int32 Y, float& Height)
 	{
-		for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+		const FVector2f Position(X, Y);
+		const float Time = FVector2f::DotProduct(Position - FVector2f(Start), Direction);
+		if (Time < 0 || Time > Length)
 		{
-			const FVector2f Position(X, Y);
-			const float Time = FVector2f::DotProduct(Position - FVector2f(Start), Direction);
-			if (Time < 0 || Time > Length)
-			{
-				continue;
-			}
-
-			const FVector2f ProjectedPoint = FVector2f(Start) + Time * Direction;
-			const float Distance = FVector2f::Distance(ProjectedPoint, Position);
-			if (Distance > Width)
-			{
-				continue;
-			}
-
-			Bounds += FVector2D(X, Y);
-
-			const int32 Index = FVoxelUtilities::Get2DIndex<int32>(Size, X, Y);
-			const float NewValue = FMath::Lerp(StartValue, EndValue, Time / Length);
-			ApplyBehavior(DataView[Index], NewValue, Behavior);
+			return false;
 		}
-	}
+
+		const FVector2f ProjectedPoint = FVector2f(Start) + Time * Direction;
+		const float Distance = FVector2f::Distance(ProjectedPoint, Position);
+		if (Distance > Width)
+		{
+			return false;
+		}
+
+		Bounds += FVector2D(X, Y);
+
+		const float NewValue = FMath::Lerp(StartValue, EndValue, Time / Length);
+		ApplyBehavior(Height, NewValue, Behavior);
+		return true;
+	});
 
 	if (Bounds.IsValid())
 	{
@@ -206,7 +191,7 @@ void UVoxelHeightmapCanvasAsset::FixupData()
 		Data = MakeShared<FVoxelHeightmapCanvasData>();
 	}
 
-	Size = FVoxelUtilities::Clamp(Size, 1, 4096);
+	Size = FVoxelUtilities::Clamp(Size, 1, FVoxelHeightmapCanvasData::MaxSize);
 
 	if (Data->GetSize() != Size)
 	{
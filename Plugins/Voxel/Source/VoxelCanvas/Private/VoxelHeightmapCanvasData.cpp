@@ -4,19 +4,148 @@
 
 DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelHeightmapCanvasMemory);
 
+void FVoxelHeightmapCanvasData::FTile::GetHeights(const TVoxelArrayView<float> OutHeights) const
+{
+	check(OutHeights.Num() == TileCount);
+
+	for (int32 Index = 0; Index < TileCount; Index++)
+	{
+		OutHeights[Index] = GetHeight(Index);
+	}
+}
+
+void FVoxelHeightmapCanvasData::FTile::SetHeights(
+	const TConstVoxelArrayView<float> NewHeights,
+	const FIntPoint& LocalMin,
+	const FIntPoint& LocalMax,
+	const bool bNewTile)
+{
+	check(NewHeights.Num() == TileCount);
+
+	float NewMin = MAX_flt;
+	float NewMax = -MAX_flt;
+	for (int32 Y = LocalMin.Y; Y <= LocalMax.Y; Y++)
+	{
+		for (int32 X = LocalMin.X; X <= LocalMax.X; X++)
+		{
+			const float Height = NewHeights[FVoxelUtilities::Get2DIndex<int32>(TileSize, X, Y)];
+			NewMin = FMath::Min(NewMin, Height);
+			NewMax = FMath::Max(NewMax, Height);
+		}
+	}
+
+	const auto Encode = [&](const int32 Index, const float Height)
+	{
+		Heights[Index] = FVoxelUtilities::FloatToUINT16(Min == Max ? 0.f : (Height - Min) / (Max - Min));
+	};
+
+	const bool bCoversTile =
+		LocalMin == FIntPoint::ZeroValue &&
+		LocalMax == FIntPoint(TileSize - 1);
+
+	if (!(bNewTile && bCoversTile) &&
+		Min <= NewMin &&
+		NewMax <= Max)
+	{
+		// Range is unchanged, only encode the edited heights
+		for (int32 Y = LocalMin.Y; Y <= LocalMax.Y; Y++)
+		{
+			for (int32 X = LocalMin.X; X <= LocalMax.X; X++)
+			{
+				const int32 Index = FVoxelUtilities::Get2DIndex<int32>(TileSize, X, Y);
+				Encode(Index, NewHeights[Index]);
+			}
+		}
+		return;
+	}
+
+	// Range needs to grow: decode the untouched heights before re-encoding the whole tile
+	TVoxelStaticArray<float, TileCount> AllHeights{ NoInit };
+	if (bCoversTile)
+	{
+		FVoxelUtilities::Memcpy(AllHeights, NewHeights);
+	}
+	else
+	{
+		GetHeights(AllHeights);
+
+		for (int32 Y = LocalMin.Y; Y <= LocalMax.Y; Y++)
+		{
+			for (int32 X = LocalMin.X; X <= LocalMax.X; X++)
+			{
+				const int32 Index = FVoxelUtilities::Get2DIndex<int32>(TileSize, X, Y);
+				AllHeights[Index] = NewHeights[Index];
+			}
+		}
+	}
+
+	if (bNewTile && bCoversTile)
+	{
+		// Nothing to preserve
+		Min = NewMin;
+		Max = NewMax;
+	}
+	else
+	{
+		Min = FMath::Min(Min, NewMin);
+		Max = FMath::Max(Max, NewMax);
+	}
+
+	for (int32 Index = 0; Index < TileCount; Index++)
+	{
+		Encode(Index, AllHeights[Index]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int64 FVoxelHeightmapCanvasData::GetAllocatedSize() const
+{
+	int64 AllocatedSize = Tiles.GetAllocatedSize();
+	for (const TUniquePtr<FTile>& Tile : Tiles)
+	{
+		if (Tile)
+		{
+			AllocatedSize += sizeof(FTile);
+		}
+	}
+	return AllocatedSize;
+}
+
+float FVoxelHeightmapCanvasData::GetHeight(const int32 X, const int32 Y) const
+{
+	checkVoxelSlow(0 <= X && X < Size.X);
+	checkVoxelSlow(0 <= Y && Y < Size.Y);
+
+	const FTile* Tile = GetTile(FIntPoint(X >> TileSizeLog2, Y >> TileSizeLog2));
+	if (!Tile)
+	{
+		return 0.f;
+	}
+
+	return Tile->GetHeight(FVoxelUtilities::Get2DIndex<int32>(TileSize, X & (TileSize - 1), Y & (TileSize - 1)));
+}
+
 void FVoxelHeightmapCanvasData::Initialize(const FIntPoint& NewSize)
 {
 	VOXEL_FUNCTION_COUNTER();
 
 	if (!ensure(Size == FIntPoint::ZeroValue) ||
-		!ensure(0 < NewSize.X && NewSize.X < 4096) ||
-		!ensure(0 < NewSize.Y && NewSize.Y < 4096))
+		!ensure(0 < NewSize.X && NewSize.X <= MaxSize) ||
+		!ensure(0 < NewSize.Y && NewSize.Y <= MaxSize))
 	{
 		return;
 	}
 
 	Size = NewSize;
-	FVoxelUtilities::SetNumFast(Data, Size.X * Size.Y);
+	NumTiles = FIntPoint(
+		FVoxelUtilities::DivideCeil_Positive(Size.X, TileSize),
+		FVoxelUtilities::DivideCeil_Positive(Size.Y, TileSize));
+
+	Tiles.Empty();
+	Tiles.SetNum(NumTiles.X * NumTiles.Y);
 
 	UpdateStats();
 }
@@ -27,17 +156,79 @@ void FVoxelHeightmapCanvasData::Serialize(FArchive& Ar)
 
 	using FVersion = DECLARE_VOXEL_VERSION
 	(
-		FirstVersion
+		FirstVersion,
+		TiledStorage
 	);
 
 	int32 Version = FVersion::LatestVersion;
 	Ar << Version;
-	check(Version == FVersion::FirstVersion);
+	check(Version <= FVersion::LatestVersion);
 
-	Ar << Size;
+	if (Ar.IsLoading())
+	{
+		FIntPoint NewSize;
+		Ar << NewSize;
 
-	FVoxelUtilities::SetNumFast(Data, Size.X * Size.Y);
-	Ar.Serialize(Data.GetData(), Size.X * Size.Y * Data.GetTypeSize());
+		Size = FIntPoint::ZeroValue;
+		Initialize(NewSize);
+
+		if (!ensure(Size == NewSize))
+		{
+			Ar.SetError();
+			return;
+		}
+
+		if (Version < FVersion::TiledStorage)
+		{
+			TVoxelArray<float> Data;
+			FVoxelUtilities::SetNumFast(Data, Size.X * Size.Y);
+			Ar.Serialize(Data.GetData(), Size.X * Size.Y * Data.GetTypeSize());
+
+			Edit(FIntPoint::ZeroValue, Size - 1, [&](const int32 X, const int32 Y, float& Height)
+			{
+				Height = Data[FVoxelUtilities::Get2DIndex<int32>(Size, X, Y)];
+				return Height != 0.f;
+			});
+			return;
+		}
+	}
+	else
+	{
+		Ar << Size;
+	}
+
+	// Only tiles that were edited are saved
+	TVoxelArray<int32> AllocatedTiles;
+	if (Ar.IsSaving())
+	{
+		for (int32 Index = 0; Index < Tiles.Num(); Index++)
+		{
+			if (Tiles[Index])
+			{
+				AllocatedTiles.Add(Index);
+			}
+		}
+	}
+	Ar << AllocatedTiles;
+
+	for (const int32 TileIndex : AllocatedTiles)
+	{
+		if (!ensure(Tiles.IsValidIndex(TileIndex)))
+		{
+			Ar.SetError();
+			return;
+		}
+
+		TUniquePtr<FTile>& Tile = Tiles[TileIndex];
+		if (Ar.IsLoading())
+		{
+			Tile = MakeUnique<FTile>();
+		}
+
+		Ar << Tile->Min;
+		Ar << Tile->Max;
+		Ar.Serialize(Tile->Heights.GetData(), Tile->Heights.Num() * sizeof(uint16));
+	}
 
 	UpdateStats();
-}
\ No newline at end of file
+}
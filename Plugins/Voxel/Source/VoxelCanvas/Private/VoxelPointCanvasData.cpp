@@ -386,12 +386,21 @@ TVoxelArray<FVoxelIntBox> FLODData::GetChunkBounds() const
 void FLODData::AddPoints(const TVoxelArray<FVector3f>& Vertices)
 {
 	VOXEL_FUNCTION_COUNTER();
-	ensure(Vertices.Num() % 3 == 0);
 	checkVoxelSlow(CriticalSection.IsLocked_Write_Debug());
 
-	LastVertices = Vertices;
+	TVoxelIntVectorMap<TVoxelArray<FPoint>> ChunkKeyToPoints;
+	RasterizeTriangles(Vertices, ChunkKeyToPoints);
 
-	FChunk* Chunk = nullptr;
+	ApplyPoints(Vertices, {}, ChunkKeyToPoints);
+}
+
+void FLODData::RasterizeTriangles(const TVoxelArray<FVector3f>& Vertices, TVoxelIntVectorMap<TVoxelArray<FPoint>>& OutChunkKeyToPoints)
+{
+	VOXEL_FUNCTION_COUNTER();
+	ensure(Vertices.Num() % 3 == 0);
+
+	FIntVector LastChunkKey = FIntVector(MAX_int32);
+	TVoxelArray<FPoint>* Points = nullptr;
 
 	const int32 NumTriangles = Vertices.Num() / 3;
 	for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
@@ -466,15 +475,15 @@ void FLODData::AddPoints(const TVoxelArray<FVector3f>& Vertices)
 
 					const FIntVector ChunkKey = FVoxelUtilities::DivideFloor_FastLog2(Position, ChunkSizeLog2);
 
-					if (!Chunk || Chunk->ChunkKey != ChunkKey)
+					if (!Points || LastChunkKey != ChunkKey)
 					{
-						Chunk = &FindOrAddChunk(ChunkKey);
-						Chunk->Invalidate(EChunkState::Uninitialized);
+						LastChunkKey = ChunkKey;
+						Points = &OutChunkKeyToPoints.FindOrAdd(ChunkKey);
 					}
 
 					const FIntVector LocalPosition = Position - ChunkKey * ChunkSize;
 
-					Chunk->Points.Add(FPoint::Make(
+					Points->Add(FPoint::Make(
 						LocalPosition,
 						DirectionK,
 						Alpha,
@@ -483,6 +492,46 @@ void FLODData::AddPoints(const TVoxelArray<FVector3f>& Vertices)
 			}
 		}
 	}
+}
+
+void FLODData::ApplyPoints(
+	const TVoxelArray<FVector3f>& Vertices,
+	const TConstVoxelArrayView<FIntVector> ChunkKeysToClear,
+	TVoxelIntVectorMap<TVoxelArray<FPoint>>& ChunkKeyToPoints)
+{
+	VOXEL_FUNCTION_COUNTER();
+	checkVoxelSlow(CriticalSection.IsLocked_Write_Debug());
+
+	LastVertices = Vertices;
+
+	for (const FIntVector& ChunkKey : ChunkKeysToClear)
+	{
+		FChunk* Chunk = FindChunk(ChunkKey);
+		if (!ensure(Chunk))
+		{
+			continue;
+		}
+
+		Chunk->Points.Reset();
+		Chunk->Invalidate(EChunkState::Uninitialized);
+		DirtyChunkKeys.Add(ChunkKey);
+	}
+
+	for (auto& It : ChunkKeyToPoints)
+	{
+		FChunk& Chunk = FindOrAddChunk(It.Key);
+		Chunk.Invalidate(EChunkState::Uninitialized);
+		DirtyChunkKeys.Add(It.Key);
+
+		if (Chunk.Points.Num() == 0)
+		{
+			Chunk.Points = MoveTemp(It.Value);
+		}
+		else
+		{
+			Chunk.Points.Append(It.Value);
+		}
+	}
 
 	JumpFloodChunks();
 
@@ -494,18 +543,56 @@ void FLODData::JumpFloodChunks()
 	VOXEL_FUNCTION_COUNTER();
 	checkVoxelSlow(CriticalSection.IsLocked_Write_Debug());
 
+	if (DirtyChunkKeys.Num() == 0)
+	{
+		return;
+	}
+
+	// Cleanup only depends on direct neighbors, and borders are added around those
+	// so chunks further than 2 chunks away from a dirty chunk are never added or removed
+	// Invalidation cascades from faces to edges to corners, reaching chunks up to 3 away
+	FVoxelIntVectorSet ChunkKeysToUpdate;
+	FVoxelIntVectorSet ChunkKeysToJumpFlood;
+	for (const FIntVector& ChunkKey : DirtyChunkKeys)
+	{
+		for (int32 X = -3; X <= 3; X++)
+		{
+			for (int32 Y = -3; Y <= 3; Y++)
+			{
+				for (int32 Z = -3; Z <= 3; Z++)
+				{
+					ChunkKeysToJumpFlood.Add(ChunkKey + FIntVector(X, Y, Z));
+
+					if (FMath::Abs(X) <= 2 &&
+						FMath::Abs(Y) <= 2 &&
+						FMath::Abs(Z) <= 2)
+					{
+						ChunkKeysToUpdate.Add(ChunkKey + FIntVector(X, Y, Z));
+					}
+				}
+			}
+		}
+	}
+	DirtyChunkKeys.Reset();
+
 	{
 		VOXEL_SCOPE_COUNTER("Cleanup");
 
 		// Remove chunks with no points at all (including in their neighbors)
-		for (auto It = Chunks.CreateIterator(); It; ++It)
+		for (const FIntVector& ChunkKey : ChunkKeysToUpdate)
 		{
+			const FChunk* Chunk = FindChunk(ChunkKey);
+			if (!Chunk)
+			{
+				continue;
+			}
+
 			const bool bHasPoints = INLINE_LAMBDA
 			{
-				for (const FChunk* Chunk : It.Value()->Chunks)
+				for (const FChunk* NeighborChunk : Chunk->Chunks)
 				{
-					if (Chunk &&
-						Chunk->Points.Num() > 0)
+					if (NeighborChunk &&
+						NeighborChunk->Points.Num() > 0)
 					{
 						return true;
 					}
@@ -515,15 +602,17 @@ void FLODData::JumpFloodChunks()
 
 			if (!bHasPoints)
 			{
-				It.RemoveCurrent();
-				RecomputeNeighbors(It.Key());
+				Chunks.Remove(ChunkKey);
+				RecomputeNeighbors(ChunkKey);
 			}
 		}
 
 		// Add a 1 chunk wide border
-		for (auto& It : MakeCopy(Chunks))
+		for (const FIntVector& ChunkKey : ChunkKeysToUpdate)
 		{
-			if (It.Value->Points.Num() == 0)
+			const FChunk* Chunk = FindChunk(ChunkKey);
+			if (!Chunk ||
+				Chunk->Points.Num() == 0)
 			{
 				continue;
 			}
@@ -534,22 +623,43 @@ void FLODData::JumpFloodChunks()
 				{
 					for (int32 Z = -1; Z <= 1; Z++)
 					{
-						FindOrAddChunk(It.Key + FIntVector(X, Y, Z));
+						FindOrAddChunk(ChunkKey + FIntVector(X, Y, Z));
 					}
 				}
 			}
 		}
 	}
 
-	for (EChunkState::Type State = EChunkState::JumpFlooded_Self; State <= EChunkState::JumpFlooded_Corners; State = EChunkState::Type(State + 1))
+	TVoxelArray<FChunk*> ChunksToJumpFlood;
+	for (const FIntVector& ChunkKey : ChunkKeysToJumpFlood)
 	{
-		VOXEL_SCOPE_COUNTER("JumpFlood");
-
-		for (const auto& It : Chunks)
+		FChunk* Chunk = FindChunk(ChunkKey);
+		if (Chunk &&
+			Chunk->NeedsJumpFlood())
 		{
-			It.Value->JumpFlood(State);
+			ChunksToJumpFlood.Add(Chunk);
 		}
 	}
+
+#if VOXEL_DEBUG
+	for (const auto& It : Chunks)
+	{
+		ensure(!It.Value->NeedsJumpFlood() || ChunksToJumpFlood.Contains(It.Value.Get()));
+	}
+#endif
+
+	// A chunk jump flood only reads its neighbors points, never their indices
+	// so all the passes of a chunk can run independently of the other chunks
+	VOXEL_SCOPE_COUNTER_FORMAT("JumpFlood %d chunks", ChunksToJumpFlood.Num());
+
+	ParallelFor(ChunksToJumpFlood.Num(), [&](const int32 Index)
+	{
+		FChunk& Chunk = *ChunksToJumpFlood[Index];
+		for (EChunkState::Type State = EChunkState::JumpFlooded_Self; State <= EChunkState::JumpFlooded_Corners; State = EChunkState::Type(State + 1))
+		{
+			Chunk.JumpFlood(State);
+		}
+	});
 }
 
 void FLODData::RecomputeNeighbors(const FIntVector& ChunkKey)
@@ -593,32 +703,47 @@ void FLODData::EditPoints(const TFunctionRef<bool(FVoxelIntBox)> ShouldVisitChun
 {
 	VOXEL_FUNCTION_COUNTER();
 
-	FVoxelScopeLock_Write Lock(CriticalSection);
-	
-	TVoxelArray<FVector3f> Vertices;
-	TVoxelArray<FChunk*> ChunksToInvalidate;
+	// Readers are only blocked while the new points are applied
+	VOXEL_SCOPE_LOCK(EditCriticalSection);
 
-	for (const auto& It : Chunks)
+	TVoxelArray<FVector3f> Vertices;
+	TVoxelArray<FIntVector> ChunkKeysToClear;
 	{
-		if (It.Value->Points.Num() == 0 ||
-			!ShouldVisitChunk(FVoxelIntBox(It.Key).Scale(ChunkSize)))
+		FVoxelScopeLock_Read Lock(CriticalSection);
+
+		for (const auto& It : Chunks)
 		{
-			continue;
+			if (It.Value->Points.Num() == 0 ||
+				!ShouldVisitChunk(FVoxelIntBox(It.Key).Scale(ChunkSize)))
+			{
+				continue;
+			}
+
+			ChunkKeysToClear.Add(It.Key);
 		}
 
-		ChunksToInvalidate.Add(It.Value.Get());
-		GenerateTriangles(It.Value->ChunkKey * ChunkSize, Vertices);
-	}
+		TVoxelArray<TVoxelArray<FVector3f>> ChunksVertices;
+		ChunksVertices.SetNum(ChunkKeysToClear.Num());
 
-	for (FChunk* Chunk : ChunksToInvalidate)
-	{
-		Chunk->Points.Reset();
-		Chunk->Invalidate(EChunkState::Uninitialized);
+		// Only reads the chunks
+		ParallelFor(ChunkKeysToClear.Num(), [&](const int32 Index)
+		{
+			GenerateTriangles(ChunkKeysToClear[Index] * ChunkSize, ChunksVertices[Index]);
+		});
+
+		for (const TVoxelArray<FVector3f>& ChunkVertices : ChunksVertices)
+		{
+			Vertices.Append(ChunkVertices);
+		}
 	}
 
 	EditPoints(Vertices);
 
-	AddPoints(Vertices);
+	TVoxelIntVectorMap<TVoxelArray<FPoint>> ChunkKeyToPoints;
+	RasterizeTriangles(Vertices, ChunkKeyToPoints);
+
+	FVoxelScopeLock_Write Lock(CriticalSection);
+	ApplyPoints(Vertices, ChunkKeysToClear, ChunkKeyToPoints);
 }
 
 void FLODData::GenerateTriangles(const FIntVector& Start, TVoxelArray<FVector3f>& OutVertices) const
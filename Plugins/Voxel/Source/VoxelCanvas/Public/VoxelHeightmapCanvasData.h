@@ -8,33 +8,128 @@ DECLARE_VOXEL_MEMORY_STAT(VOXELCANVAS_API, STAT_VoxelHeightmapCanvasMemory, "Vox
 
 class VOXELCANVAS_API FVoxelHeightmapCanvasData
 {
+public:
+	static constexpr int32 MaxSize = 16384;
+	static constexpr int32 TileSize = 64;
+	static constexpr int32 TileSizeLog2 = FVoxelUtilities::ExactLog2<TileSize>();
+	static constexpr int32 TileCount = TileSize * TileSize;
+
+	struct FTile
+	{
+		// Heights are quantized between Min and Max
+		float Min = 0.f;
+		float Max = 0.f;
+		TVoxelStaticArray<uint16, TileCount> Heights{ ForceInit };
+
+		FORCEINLINE float GetHeight(const int32 Index) const
+		{
+			return FMath::Lerp(Min, Max, FVoxelUtilities::UINT16ToFloat(Heights[Index]));
+		}
+
+		void GetHeights(TVoxelArrayView<float> OutHeights) const;
+		// Only the heights in [LocalMin, LocalMax] are read from NewHeights
+		// The existing range is kept if the new heights fit in it, so that untouched heights don't drift
+		void SetHeights(
+			TConstVoxelArrayView<float> NewHeights,
+			const FIntPoint& LocalMin,
+			const FIntPoint& LocalMax,
+			bool bNewTile);
+	};
+
 public:
 	FVoxelHeightmapCanvasData() = default;
 
 	VOXEL_ALLOCATED_SIZE_TRACKER(STAT_VoxelHeightmapCanvasMemory);
 
-	int64 GetAllocatedSize() const
-	{
-		return Data.GetAllocatedSize();
-	}
+	int64 GetAllocatedSize() const;
 
 	FORCEINLINE const FIntPoint& GetSize() const
 	{
 		return Size;
 	}
-	FORCEINLINE TVoxelArrayView<float> GetData()
+	FORCEINLINE const FIntPoint& GetNumTiles() const
 	{
-		return Data;
+		return NumTiles;
 	}
-	FORCEINLINE TConstVoxelArrayView<float> GetData() const
+	// Null if the tile was never edited, all its heights are 0 then
+	FORCEINLINE const FTile* GetTile(const FIntPoint& TileKey) const
 	{
-		return Data;
+		return Tiles[FVoxelUtilities::Get2DIndex<int32>(NumTiles, TileKey)].Get();
 	}
 
+	float GetHeight(int32 X, int32 Y) const;
+
 	void Initialize(const FIntPoint& NewSize);
 	void Serialize(FArchive& Ar);
 
+	// Lambda: bool(int32 X, int32 Y, float& Height), returns true if Height was modified
+	// Called for every position in [Min, Max], both clamped to the canvas
+	// Only the tiles that were modified are allocated
+	template<typename LambdaType>
+	void Edit(FIntPoint Min, FIntPoint Max, LambdaType&& Lambda)
+	{
+		VOXEL_FUNCTION_COUNTER();
+
+		Min = FVoxelUtilities::Clamp(Min, FIntPoint::ZeroValue, Size - 1);
+		Max = FVoxelUtilities::Clamp(Max, FIntPoint::ZeroValue, Size - 1);
+
+		if (Min.X > Max.X ||
+			Min.Y > Max.Y)
+		{
+			return;
+		}
+
+		const FIntPoint MinTile = FIntPoint(Min.X >> TileSizeLog2, Min.Y >> TileSizeLog2);
+		const FIntPoint MaxTile = FIntPoint(Max.X >> TileSizeLog2, Max.Y >> TileSizeLog2);
+
+		bool bEdited = false;
+		TVoxelStaticArray<float, TileCount> Heights{ NoInit };
+
+		for (int32 TileY = MinTile.Y; TileY <= MaxTile.Y; TileY++)
+		{
+			for (int32 TileX = MinTile.X; TileX <= MaxTile.X; TileX++)
+			{
+				TUniquePtr<FTile>& Tile = Tiles[FVoxelUtilities::Get2DIndex<int32>(NumTiles, TileX, TileY)];
+
+				const FIntPoint TileMin = FIntPoint(TileX, TileY) * TileSize;
+				const FIntPoint LocalMin = FVoxelUtilities::ComponentMax(Min, TileMin) - TileMin;
+				const FIntPoint LocalMax = FVoxelUtilities::ComponentMin(Max, TileMin + FIntPoint(TileSize - 1)) - TileMin;
+
+				bool bModified = false;
+				for (int32 Y = LocalMin.Y; Y <= LocalMax.Y; Y++)
+				{
+					for (int32 X = LocalMin.X; X <= LocalMax.X; X++)
+					{
+						const int32 Index = FVoxelUtilities::Get2DIndex<int32>(TileSize, X, Y);
+						Heights[Index] = Tile ? Tile->GetHeight(Index) : 0.f;
+						bModified |= Lambda(TileMin.X + X, TileMin.Y + Y, Heights[Index]);
+					}
+				}
+
+				if (!bModified)
+				{
+					continue;
+				}
+
+				const bool bNewTile = !Tile.IsValid();
+				if (bNewTile)
+				{
+					Tile = MakeUnique<FTile>();
+				}
+				Tile->SetHeights(Heights, LocalMin, LocalMax, bNewTile);
+
+				bEdited = true;
+			}
+		}
+
+		if (bEdited)
+		{
+			UpdateStats();
+		}
+	}
+
 private:
 	FIntPoint Size = FIntPoint::ZeroValue;
-	TVoxelArray<float> Data;
-};
\ No newline at end of file
+	FIntPoint NumTiles = FIntPoint::ZeroValue;
+	TVoxelArray<TUniquePtr<FTile>> Tiles;
+};
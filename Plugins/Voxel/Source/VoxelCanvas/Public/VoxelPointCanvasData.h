@@ -160,6 +160,10 @@ public:
 		checkVoxelSlow(IsReady());
 		return *Indices_Corners.Get();
 	}
+	FORCEINLINE bool NeedsJumpFlood() const
+	{
+		return State != EChunkState::JumpFlooded_Corners;
+	}
 	
 public:
 	VOXEL_ALLOCATED_SIZE_TRACKER(STAT_ChunkMemory);
@@ -334,8 +338,18 @@ public:
 
 private:
 	TVoxelIntVectorMap<TSharedPtr<FChunk>> Chunks;
+	// Chunks whose points changed since the last JumpFloodChunks
+	FVoxelIntVectorSet DirtyChunkKeys;
+	// Edits only take the write lock to apply their result, this makes sure they don't interleave
+	FVoxelCriticalSection EditCriticalSection;
 
 	void GenerateTriangles(const FIntVector& Start, TVoxelArray<FVector3f>& OutVertices) const;
+
+	static void RasterizeTriangles(const TVoxelArray<FVector3f>& Vertices, TVoxelIntVectorMap<TVoxelArray<FPoint>>& OutChunkKeyToPoints);
+	void ApplyPoints(
+		const TVoxelArray<FVector3f>& Vertices,
+		TConstVoxelArrayView<FIntVector> ChunkKeysToClear,
+		TVoxelIntVectorMap<TVoxelArray<FPoint>>& ChunkKeyToPoints);
 };
 
 struct VOXELCANVAS_API FUtilities
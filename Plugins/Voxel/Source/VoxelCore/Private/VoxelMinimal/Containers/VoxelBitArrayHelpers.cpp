@@ -1,6 +1,7 @@
 ﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
 
 #include "VoxelMinimal.h"
+#include "VoxelBitArrayHelpersImpl.ispc.generated.h"
 
 bool FVoxelBitArrayHelpers::TestRangeImpl(const uint32* RESTRICT ArrayData, int32 Index, int32 Num)
 {
@@ -611,4 +612,56 @@ int64 FVoxelBitArrayHelpers::CountSetBits_UpperBound(const uint32* RESTRICT Data
 #endif
 
 	return Count;
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelBitArrayHelpers::PackValues(
+	const int32 TypeSizeInBits,
+	uint32* RESTRICT ArrayData,
+	const TConstArrayView<uint32> Values)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(0 < TypeSizeInBits && TypeSizeInBits <= NumBitsPerWord);
+
+	if (!FMath::IsPowerOfTwo(TypeSizeInBits))
+	{
+		for (int32 Index = 0; Index < Values.Num(); Index++)
+		{
+			SetPacked(TypeSizeInBits, ArrayData, Index, Values[Index]);
+		}
+		return;
+	}
+
+	ispc::BitArrayHelpers_PackValues(
+		ArrayData,
+		Values.GetData(),
+		FMath::FloorLog2(TypeSizeInBits),
+		Values.Num());
+}
+
+void FVoxelBitArrayHelpers::UnpackValues(
+	const int32 TypeSizeInBits,
+	const uint32* RESTRICT ArrayData,
+	const TArrayView<uint32> OutValues)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(0 < TypeSizeInBits && TypeSizeInBits <= NumBitsPerWord);
+
+	if (!FMath::IsPowerOfTwo(TypeSizeInBits))
+	{
+		for (int32 Index = 0; Index < OutValues.Num(); Index++)
+		{
+			OutValues[Index] = GetPacked(TypeSizeInBits, ArrayData, Index);
+		}
+		return;
+	}
+
+	ispc::BitArrayHelpers_UnpackValues(
+		ArrayData,
+		OutValues.GetData(),
+		FMath::FloorLog2(TypeSizeInBits),
+		OutValues.Num());
+}
@@ -0,0 +1,79 @@
+﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
+
+#include "VoxelMinimal.h"
+
+int64 FVoxelMinMaxPyramid::GetAllocatedSize() const
+{
+	int64 AllocatedSize = Mips.GetAllocatedSize();
+	for (const FMip& Mip : Mips)
+	{
+		AllocatedSize += Mip.Values.GetAllocatedSize();
+	}
+	return AllocatedSize;
+}
+
+FFloatInterval FVoxelMinMaxPyramid::GetMinMax(FIntPoint Min, FIntPoint Max) const
+{
+	if (!ensure(IsValid()))
+	{
+		return FFloatInterval(0.f, 0.f);
+	}
+
+	Min = FVoxelUtilities::Clamp(Min, FIntPoint::ZeroValue, GetSize() - 1);
+	Max = FVoxelUtilities::Clamp(Max, FIntPoint::ZeroValue, GetSize() - 1);
+
+	if (Min.X > Max.X) { Swap(Min.X, Max.X); }
+	if (Min.Y > Max.Y) { Swap(Min.Y, Max.Y); }
+
+	// Find the first mip where the region spans at most 2x2 cells
+	const int32 Extent = FMath::Max(Max.X - Min.X, Max.Y - Min.Y);
+	int32 MipIndex = Extent > 0 ? FMath::FloorLog2(Extent) : 0;
+	while (
+		MipIndex < Mips.Num() - 1 &&
+		((Max.X >> MipIndex) - (Min.X >> MipIndex) > 1 ||
+		 (Max.Y >> MipIndex) - (Min.Y >> MipIndex) > 1))
+	{
+		MipIndex++;
+	}
+	MipIndex = FMath::Min(MipIndex, Mips.Num() - 1);
+
+	const FMip& Mip = Mips[MipIndex];
+	const FIntPoint MipMin = FIntPoint(Min.X >> MipIndex, Min.Y >> MipIndex);
+	const FIntPoint MipMax = FIntPoint(Max.X >> MipIndex, Max.Y >> MipIndex);
+
+	FFloatInterval Result(MAX_flt, -MAX_flt);
+	for (int32 Y = MipMin.Y; Y <= MipMax.Y; Y++)
+	{
+		for (int32 X = MipMin.X; X <= MipMax.X; X++)
+		{
+			const FFloatInterval& Value = Mip.Values[FVoxelUtilities::Get2DIndex<int32>(Mip.Size, X, Y)];
+			Result.Min = FMath::Min(Result.Min, Value.Min);
+			Result.Max = FMath::Max(Result.Max, Value.Max);
+		}
+	}
+	return Result;
+}
+
+void FVoxelMinMaxPyramid::UpdateMip(const int32 MipIndex, const FIntPoint& Min, const FIntPoint& Max)
+{
+	const FMip& Child = Mips[MipIndex - 1];
+	FMip& Mip = Mips[MipIndex];
+
+	for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+	{
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			FFloatInterval Value(MAX_flt, -MAX_flt);
+			for (int32 ChildY = 2 * Y; ChildY < FMath::Min(2 * Y + 2, Child.Size.Y); ChildY++)
+			{
+				for (int32 ChildX = 2 * X; ChildX < FMath::Min(2 * X + 2, Child.Size.X); ChildX++)
+				{
+					const FFloatInterval& ChildValue = Child.Values[FVoxelUtilities::Get2DIndex<int32>(Child.Size, ChildX, ChildY)];
+					Value.Min = FMath::Min(Value.Min, ChildValue.Min);
+					Value.Max = FMath::Max(Value.Max, ChildValue.Max);
+				}
+			}
+			Mip.Values[FVoxelUtilities::Get2DIndex<int32>(Mip.Size, X, Y)] = Value;
+		}
+	}
+}
@@ -108,6 +108,7 @@
 #include "VoxelMinimal/Containers/VoxelArrayView.h"
 #include "VoxelMinimal/Containers/VoxelBitArray.h"
 #include "VoxelMinimal/Containers/VoxelFlatOctree.h"
+#include "VoxelMinimal/Containers/VoxelMinMaxPyramid.h"
 #include "VoxelMinimal/Containers/VoxelSparseArray.h"
 #include "VoxelMinimal/Containers/VoxelStaticBitArray.h"
 #include "VoxelMinimal/Containers/VoxelPackedData.h"
@@ -117,6 +118,7 @@
 
 #include "VoxelMinimal/Utilities/VoxelGameUtilities.h"
 #include "VoxelMinimal/Utilities/VoxelMathUtilities.h"
+#include "VoxelMinimal/Utilities/VoxelIntervalUtilities.h"
 #include "VoxelMinimal/Utilities/VoxelSystemUtilities.h"
 #include "VoxelMinimal/Utilities/VoxelRenderUtilities.h"
 #include "VoxelMinimal/Utilities/VoxelObjectUtilities.h"
@@ -465,6 +465,18 @@ public:
 	}
 	static int64 CountSetBits(const uint32* RESTRICT Data, int32 NumWords);
 	static int64 CountSetBits_UpperBound(const uint32* RESTRICT Data, int32 NumBits);
+
+public:
+	// Bulk versions of GetPacked/SetPacked
+	// Vectorized if TypeSizeInBits is a power of two, as values never straddle words then
+	static void PackValues(
+		int32 TypeSizeInBits,
+		uint32* RESTRICT ArrayData,
+		TConstArrayView<uint32> Values);
+	static void UnpackValues(
+		int32 TypeSizeInBits,
+		const uint32* RESTRICT ArrayData,
+		TArrayView<uint32> OutValues);
 };
 
 template<typename T>
@@ -0,0 +1,110 @@
+﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "VoxelCoreMinimal.h"
+#include "VoxelMinimal/Containers/VoxelArray.h"
+#include "VoxelMinimal/Utilities/VoxelBaseUtilities.h"
+#include "VoxelMinimal/Utilities/VoxelVectorUtilities.h"
+
+// Min/max mip chain over a 2D grid of cells
+// Used to conservatively bound the values of a heightmap over a region in O(1)
+class VOXELCORE_API FVoxelMinMaxPyramid
+{
+public:
+	FVoxelMinMaxPyramid() = default;
+
+	int64 GetAllocatedSize() const;
+
+	FORCEINLINE bool IsValid() const
+	{
+		return Mips.Num() > 0;
+	}
+	FORCEINLINE FIntPoint GetSize() const
+	{
+		return Mips.Num() > 0 ? Mips[0].Size : FIntPoint::ZeroValue;
+	}
+	FORCEINLINE FFloatInterval GetGlobalMinMax() const
+	{
+		checkVoxelSlow(IsValid());
+		return Mips.Last().Values[0];
+	}
+
+	// Lambda: FFloatInterval(int32 X, int32 Y), the min/max of a cell
+	template<typename LambdaType>
+	void Initialize(const FIntPoint& Size, LambdaType&& GetCellMinMax)
+	{
+		VOXEL_FUNCTION_COUNTER();
+
+		Mips.Reset();
+
+		if (!ensure(Size.X > 0) ||
+			!ensure(Size.Y > 0))
+		{
+			return;
+		}
+
+		FIntPoint MipSize = Size;
+		while (true)
+		{
+			FMip& Mip = Mips.Emplace_GetRef();
+			Mip.Size = MipSize;
+			FVoxelUtilities::SetNumFast(Mip.Values, MipSize.X * MipSize.Y);
+
+			if (MipSize == FIntPoint(1, 1))
+			{
+				break;
+			}
+
+			MipSize = FIntPoint(
+				FVoxelUtilities::DivideCeil_Positive(MipSize.X, 2),
+				FVoxelUtilities::DivideCeil_Positive(MipSize.Y, 2));
+		}
+
+		Update(FIntPoint::ZeroValue, Size - 1, GetCellMinMax);
+	}
+
+	// Recompute the cells in [Min, Max] (inclusive) and their parents
+	template<typename LambdaType>
+	void Update(FIntPoint Min, FIntPoint Max, LambdaType&& GetCellMinMax)
+	{
+		VOXEL_FUNCTION_COUNTER();
+
+		if (!ensure(IsValid()))
+		{
+			return;
+		}
+
+		Min = FVoxelUtilities::ComponentMax(Min, FIntPoint::ZeroValue);
+		Max = FVoxelUtilities::ComponentMin(Max, GetSize() - 1);
+
+		for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+		{
+			for (int32 X = Min.X; X <= Max.X; X++)
+			{
+				Mips[0].Values[FVoxelUtilities::Get2DIndex<int32>(Mips[0].Size, X, Y)] = GetCellMinMax(X, Y);
+			}
+		}
+
+		for (int32 MipIndex = 1; MipIndex < Mips.Num(); MipIndex++)
+		{
+			Min = FIntPoint(Min.X >> 1, Min.Y >> 1);
+			Max = FIntPoint(Max.X >> 1, Max.Y >> 1);
+			UpdateMip(MipIndex, Min, Max);
+		}
+	}
+
+	// Conservative min/max of all the cells in [Min, Max] (inclusive, clamped)
+	// Reads at most 4 values
+	FFloatInterval GetMinMax(FIntPoint Min, FIntPoint Max) const;
+
+private:
+	struct FMip
+	{
+		FIntPoint Size = FIntPoint::ZeroValue;
+		TVoxelArray<FFloatInterval> Values;
+	};
+	TVoxelArray<FMip> Mips;
+
+	void UpdateMip(int32 MipIndex, const FIntPoint& Min, const FIntPoint& Max);
+};
@@ -151,6 +151,21 @@ public:
 		checkVoxelSlow(Get(Index) == Value);
 	}
 	
+public:
+	void SetAll(TConstArrayView<uint32> Values)
+	{
+		check(Values.Num() == ArrayNum);
+		FVoxelBitArrayHelpers::PackValues(BitsPerElement, GetData(), Values);
+	}
+	// Unpacks OutValues.Num() elements starting at StartIndex
+	// StartIndex must be a multiple of 32 for the copy to stay word-aligned
+	void GetRange(int32 StartIndex, TArrayView<uint32> OutValues) const
+	{
+		check(StartIndex % 32 == 0);
+		check(0 <= StartIndex && StartIndex + OutValues.Num() <= ArrayNum);
+		FVoxelBitArrayHelpers::UnpackValues(BitsPerElement, GetData() + StartIndex / 32 * BitsPerElement, OutValues);
+	}
+
 public:
 	friend FArchive& operator<<(FArchive& Ar, FVoxelPackedArray& Array)
 	{
@@ -24,9 +24,36 @@ public:
 			return;
 		}
 
-		for (int32 Index = 0; Index < Num; Index++)
+		TVoxelArray<uint32> PaletteIndices;
+		FVoxelUtilities::SetNumFast(PaletteIndices, Num);
 		{
-			Palette.AddUnique(GetValue(Index));
+			TMap<T, int32> ValueToPaletteIndex;
+
+			// Values are usually spatially coherent: skip the lookup for runs
+			T LastValue = GetValue(0);
+			int32 LastPaletteIndex = Palette.Add(LastValue);
+			ValueToPaletteIndex.Add(LastValue, LastPaletteIndex);
+			PaletteIndices[0] = LastPaletteIndex;
+
+			for (int32 Index = 1; Index < Num; Index++)
+			{
+				T Value = GetValue(Index);
+				if (!(Value == LastValue))
+				{
+					const uint32 Hash = GetTypeHash(Value);
+					if (const int32* PaletteIndexPtr = ValueToPaletteIndex.FindByHash(Hash, Value))
+					{
+						LastPaletteIndex = *PaletteIndexPtr;
+					}
+					else
+					{
+						LastPaletteIndex = Palette.Add(Value);
+						ValueToPaletteIndex.AddByHash(Hash, Value, LastPaletteIndex);
+					}
+					LastValue = MoveTemp(Value);
+				}
+				PaletteIndices[Index] = LastPaletteIndex;
+			}
 		}
 		Palette.Shrink();
 		checkVoxelSlow(Palette.Num() >= 1);
@@ -37,14 +64,8 @@ public:
 			return;
 		}
 
-		Indices.Initialize(FMath::CeilLogTwo(Palette.Num()), Num);
-		for (int32 Index = 0; Index < Num; Index++)
-		{
-			const int32 PaletteIndex = Palette.Find(GetValue(Index));
-			checkVoxelSlow(PaletteIndex != -1);
-
-			Indices[Index] = PaletteIndex;
-		}
+		Indices.Initialize(GetBitsPerIndex(Palette.Num()), Num);
+		Indices.SetAll(PaletteIndices);
 	}
 	template<typename ArrayType>
 	void InitializeFrom(const ArrayType& Array)
@@ -91,6 +112,40 @@ public:
 		return Get(Index);
 	}
 
+	void CopyTo(TVoxelArrayView<T> OutValues) const
+	{
+		VOXEL_FUNCTION_COUNTER();
+		check(OutValues.Num() == ArrayNum);
+
+		if (ArrayNum == 0)
+		{
+			return;
+		}
+
+		if (Palette.Num() == 1)
+		{
+			for (T& Value : OutValues)
+			{
+				Value = Palette[0];
+			}
+			return;
+		}
+
+		constexpr int32 ChunkSize = 1024;
+		uint32 PaletteIndices[ChunkSize];
+
+		for (int32 ChunkStart = 0; ChunkStart < ArrayNum; ChunkStart += ChunkSize)
+		{
+			const int32 ChunkNum = FMath::Min(ChunkSize, ArrayNum - ChunkStart);
+			Indices.GetRange(ChunkStart, MakeArrayView(PaletteIndices, ChunkNum));
+
+			for (int32 Index = 0; Index < ChunkNum; Index++)
+			{
+				OutValues[ChunkStart + Index] = Palette[PaletteIndices[Index]];
+			}
+		}
+	}
+
 	FORCEINLINE int64 GetAllocatedSize() const
 	{
 		return Palette.GetAllocatedSize() + Indices.GetAllocatedSize();
@@ -118,4 +173,11 @@ private:
 	int32 ArrayNum = 0;
 	TVoxelArray<T> Palette;
 	FVoxelPackedArray Indices;
+
+	// Power of two widths never straddle words, allowing vectorized packing & unpacking
+	static int32 GetBitsPerIndex(int32 PaletteNum)
+	{
+		const int32 NumBits = FMath::CeilLogTwo(PaletteNum);
+		return NumBits <= 1 ? 1 : int32(FMath::RoundUpToPowerOfTwo(NumBits));
+	}
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "VoxelCoreMinimal.h"
+
+// Conservative interval arithmetic: the result always contains every value the operation can produce
+// An unknown range is represented by [-MAX_flt, MAX_flt]
+namespace FVoxelUtilities
+{
+	FORCEINLINE FFloatInterval InfiniteInterval()
+	{
+		return FFloatInterval(-MAX_flt, MAX_flt);
+	}
+	FORCEINLINE FFloatInterval ConstantInterval(const float Value)
+	{
+		return FFloatInterval(Value, Value);
+	}
+	FORCEINLINE bool IsFiniteInterval(const FFloatInterval& Interval)
+	{
+		return
+			-MAX_flt < Interval.Min &&
+			Interval.Max < MAX_flt;
+	}
+	// NaNs & infinities make the interval unknown
+	FORCEINLINE FFloatInterval SanitizeInterval(const FFloatInterval& Interval)
+	{
+		if (FMath::IsNaN(Interval.Min) ||
+			FMath::IsNaN(Interval.Max) ||
+			Interval.Min > Interval.Max)
+		{
+			return InfiniteInterval();
+		}
+
+		return FFloatInterval(
+			FMath::Max(Interval.Min, -MAX_flt),
+			FMath::Min(Interval.Max, MAX_flt));
+	}
+	FORCEINLINE FFloatInterval UnionInterval(const FFloatInterval& A, const FFloatInterval& B)
+	{
+		return FFloatInterval(
+			FMath::Min(A.Min, B.Min),
+			FMath::Max(A.Max, B.Max));
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////////
+
+	FORCEINLINE FFloatInterval IntervalAdd(const FFloatInterval& A, const FFloatInterval& B)
+	{
+		return SanitizeInterval(FFloatInterval(A.Min + B.Min, A.Max + B.Max));
+	}
+	FORCEINLINE FFloatInterval IntervalSubtract(const FFloatInterval& A, const FFloatInterval& B)
+	{
+		return SanitizeInterval(FFloatInterval(A.Min - B.Max, A.Max - B.Min));
+	}
+	FORCEINLINE FFloatInterval IntervalNegate(const FFloatInterval& A)
+	{
+		return FFloatInterval(-A.Max, -A.Min);
+	}
+	FORCEINLINE FFloatInterval IntervalMultiply(const FFloatInterval& A, const FFloatInterval& B)
+	{
+		const float P0 = A.Min * B.Min;
+		const float P1 = A.Min * B.Max;
+		const float P2 = A.Max * B.Min;
+		const float P3 = A.Max * B.Max;
+
+		return SanitizeInterval(FFloatInterval(
+			FMath::Min(FMath::Min(P0, P1), FMath::Min(P2, P3)),
+			FMath::Max(FMath::Max(P0, P1), FMath::Max(P2, P3))));
+	}
+	FORCEINLINE FFloatInterval IntervalDivide(const FFloatInterval& A, const FFloatInterval& B)
+	{
+		if (B.Min <= 0.f && 0.f <= B.Max)
+		{
+			return InfiniteInterval();
+		}
+
+		return IntervalMultiply(A, FFloatInterval(1.f / B.Max, 1.f / B.Min));
+	}
+
+	FORCEINLINE FFloatInterval IntervalMin(const FFloatInterval& A, const FFloatInterval& B)
+	{
+		return FFloatInterval(
+			FMath::Min(A.Min, B.Min),
+			FMath::Min(A.Max, B.Max));
+	}
+	FORCEINLINE FFloatInterval IntervalMax(const FFloatInterval& A, const FFloatInterval& B)
+	{
+		return FFloatInterval(
+			FMath::Max(A.Min, B.Min),
+			FMath::Max(A.Max, B.Max));
+	}
+	FORCEINLINE FFloatInterval IntervalClamp(const FFloatInterval& Value, const FFloatInterval& Min, const FFloatInterval& Max)
+	{
+		return IntervalMin(IntervalMax(Value, Min), Max);
+	}
+	FORCEINLINE FFloatInterval IntervalAbs(const FFloatInterval& A)
+	{
+		if (A.Min >= 0.f)
+		{
+			return A;
+		}
+		if (A.Max <= 0.f)
+		{
+			return IntervalNegate(A);
+		}
+		return FFloatInterval(0.f, FMath::Max(-A.Min, A.Max));
+	}
+	FORCEINLINE FFloatInterval IntervalLerp(const FFloatInterval& A, const FFloatInterval& B, const FFloatInterval& Alpha)
+	{
+		return IntervalAdd(A, IntervalMultiply(IntervalSubtract(B, A), Alpha));
+	}
+
+	// Works for any monotonically increasing function
+	template<typename LambdaType>
+	FORCEINLINE FFloatInterval IntervalMonotonic(const FFloatInterval& A, LambdaType Lambda)
+	{
+		return SanitizeInterval(FFloatInterval(Lambda(A.Min), Lambda(A.Max)));
+	}
+
+	// sin/cos are only bounded by [-1, 1], unless the interval is a single value
+	FORCEINLINE FFloatInterval IntervalSin(const FFloatInterval& A)
+	{
+		if (A.Min == A.Max)
+		{
+			return ConstantInterval(FMath::Sin(A.Min));
+		}
+		return FFloatInterval(-1.f, 1.f);
+	}
+	FORCEINLINE FFloatInterval IntervalCos(const FFloatInterval& A)
+	{
+		if (A.Min == A.Max)
+		{
+			return ConstantInterval(FMath::Cos(A.Min));
+		}
+		return FFloatInterval(-1.f, 1.f);
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////////
+	//////////////////////////////////////////////////////////////////////////////
+
+	// SmoothMin(A, B, K) is in [min(A, B) - K / 4, min(A, B)]
+	FORCEINLINE FFloatInterval IntervalSmoothMin(const FFloatInterval& A, const FFloatInterval& B, const FFloatInterval& Smoothness)
+	{
+		if (Smoothness.Min < 0.f)
+		{
+			return InfiniteInterval();
+		}
+
+		const FFloatInterval Min = IntervalMin(A, B);
+		return SanitizeInterval(FFloatInterval(Min.Min - Smoothness.Max / 4.f, Min.Max));
+	}
+	// SmoothMax(A, B, K) is in [max(A, B), max(A, B) + K / 4]
+	FORCEINLINE FFloatInterval IntervalSmoothMax(const FFloatInterval& A, const FFloatInterval& B, const FFloatInterval& Smoothness)
+	{
+		if (Smoothness.Min < 0.f)
+		{
+			return InfiniteInterval();
+		}
+
+		const FFloatInterval Max = IntervalMax(A, B);
+		return SanitizeInterval(FFloatInterval(Max.Min, Max.Max + Smoothness.Max / 4.f));
+	}
+	// SmoothSubtraction(A, B, K) with B inverted is a smooth max
+	FORCEINLINE FFloatInterval IntervalSmoothSubtraction(const FFloatInterval& A, const FFloatInterval& B, const FFloatInterval& Smoothness)
+	{
+		return IntervalSmoothMax(A, B, Smoothness);
+	}
+}
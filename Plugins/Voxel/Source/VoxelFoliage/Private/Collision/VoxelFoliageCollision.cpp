@@ -3,15 +3,119 @@
 #include "Collision/VoxelFoliageCollision.h"
 #include "VoxelFoliageComponentPool.h"
 #include "Collision/VoxelFoliageCollisionComponent.h"
+#include "Collision/VoxelFoliageCollisionInvokerComponent.h"
 
 VOXEL_CONSOLE_VARIABLE(
 	VOXELFOLIAGE_API, int32, GVoxelFoliageMaxCollisionInstances, 10 * 1000 * 1000,
 	"voxel.foliage.MaxCollisionInstances",
 	"");
 
+VOXEL_CONSOLE_VARIABLE(
+	VOXELFOLIAGE_API, int32, GVoxelFoliageMaxCollisionBodiesPerFrame, 500,
+	"voxel.foliage.MaxCollisionBodiesPerFrame",
+	"Max number of foliage collision bodies created or destroyed per frame");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELFOLIAGE_API, int32, GVoxelFoliageCollisionBodyPoolSize, 4096,
+	"voxel.foliage.CollisionBodyPoolSize",
+	"Number of released foliage collision bodies kept around for reuse");
+
 DEFINE_UNIQUE_VOXEL_ID(FVoxelFoliageCollisionId);
 DEFINE_VOXEL_SUBSYSTEM(FVoxelFoliageCollision);
 
+void FVoxelFoliageCollision::Destroy()
+{
+	Super::Destroy();
+
+	for (const FBodyInstance* Body : BodyPool)
+	{
+		delete Body;
+	}
+	BodyPool.Empty();
+}
+
+void FVoxelFoliageCollision::Tick()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	Super::Tick();
+
+	TArray<FSphere> NewInvokers;
+	UVoxelFoliageCollisionInvokerComponent::GetInvokers(GetWorld(), NewInvokers);
+
+	if (HaveInvokersMoved(NewInvokers))
+	{
+		VOXEL_SCOPE_COUNTER("Rescan");
+
+		Invokers = MoveTemp(NewInvokers);
+
+		PendingComponents.Reset();
+		for (const auto& It : Components)
+		{
+			if (UVoxelFoliageCollisionComponent* Component = It.Value.Get())
+			{
+				Component->MarkPendingUpdate();
+				PendingComponents.Add(It.Key);
+			}
+		}
+	}
+
+	// Components resume where they stopped, so the first ones can't starve the others
+	int32 Budget = GVoxelFoliageMaxCollisionBodiesPerFrame;
+	PendingComponents.RemoveAll([&](const FVoxelFoliageCollisionId Id)
+	{
+		if (Budget <= 0)
+		{
+			return false;
+		}
+
+		const TWeakObjectPtr<UVoxelFoliageCollisionComponent>* Component = Components.Find(Id);
+		if (!Component ||
+			!Component->IsValid())
+		{
+			return true;
+		}
+
+		return (**Component).UpdateInstanceBodies(Invokers, Budget, BodyPool);
+	});
+
+	while (BodyPool.Num() > FMath::Max(GVoxelFoliageCollisionBodyPoolSize, 0))
+	{
+		delete BodyPool.Pop(false);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool FVoxelFoliageCollision::HaveInvokersMoved(const TConstArrayView<FSphere> NewInvokers) const
+{
+	if (NewInvokers.Num() != Invokers.Num())
+	{
+		return true;
+	}
+
+	for (int32 Index = 0; Index < Invokers.Num(); Index++)
+	{
+		const FSphere& Invoker = Invokers[Index];
+		const FSphere& NewInvoker = NewInvokers[Index];
+
+		// Small moves stay well within the 1.2x release margin: only rescan once an invoker moved a tenth of its radius
+		if (Invoker.W != NewInvoker.W ||
+			FVector::DistSquared(Invoker.Center, NewInvoker.Center) > FMath::Square(0.1f * Invoker.W))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 FVoxelFoliageCollisionId FVoxelFoliageCollision::CreateMesh(
 	const FVector3d& Position,
 	UStaticMesh* Mesh,
@@ -37,10 +141,10 @@ FVoxelFoliageCollisionId FVoxelFoliageCollision::CreateMesh(
 	{
 		NumInstances += FoliageData->Transforms->Num();
 		Component->AssignInstances(*FoliageData->Transforms);
+		PendingComponents.Add(Id);
 	}
 
-	Component->CreateAllInstanceBodies();
-
+	// Instance bodies are created in Tick, around the collision invokers
 	return Id;
 }
 
@@ -57,5 +161,6 @@ void FVoxelFoliageCollision::DestroyMesh(FVoxelFoliageCollisionId Id)
 	NumInstances -= Component->GetInstancesCount();
 	ensure(NumInstances >= 0);
 
+	Component->ReleaseAllInstanceBodies(BodyPool);
 	GetSubsystem<FVoxelFoliageComponentPool>().DestroyCollisionComponent(Component.Get());
 }
\ No newline at end of file
@@ -44,10 +44,7 @@ void UVoxelFoliageCollisionComponent::OnComponentDestroyed(bool bDestroyingHiera
 
 void UVoxelFoliageCollisionComponent::OnCreatePhysicsState()
 {
-	if (Instances.Num() != InstanceBodies.Num())
-	{
-		CreateAllInstanceBodies();
-	}
+	// Instance bodies are created incrementally by FVoxelFoliageCollision::Tick
 
 	// We want to avoid PrimitiveComponent base body instance at component location
 	USceneComponent::OnCreatePhysicsState();
@@ -80,7 +77,7 @@ void UVoxelFoliageCollisionComponent::SetStaticMesh(UStaticMesh* Mesh)
 
 void UVoxelFoliageCollisionComponent::AssignInstances(const TVoxelArray<FTransform3f>& Transforms)
 {
-	check(InstanceBodies.Num() == 0);
+	check(NumInstanceBodies == 0);
 
 	Instances.Reserve(Transforms.Num());
 	Instances.AddUninitialized(Transforms.Num());
@@ -89,28 +86,64 @@ void UVoxelFoliageCollisionComponent::AssignInstances(const TVoxelArray<FTransfo
 	{
 		Instances[Index] = FTransform(Transforms[Index]).ToMatrixWithScale();
 	}
+
+	InstanceBodies.Reset();
+	InstanceBodies.SetNumZeroed(Instances.Num());
+
+	UpdateCursor = 0;
+	NumPendingInstances = Instances.Num();
+
+	UpdateBounds();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void UVoxelFoliageCollisionComponent::CreateAllInstanceBodies()
+bool UVoxelFoliageCollisionComponent::UpdateInstanceBodies(const TConstArrayView<FSphere> Invokers, int32& Budget, TArray<FBodyInstance*>& BodyPool)
 {
 	VOXEL_FUNCTION_COUNTER();
-	check(InstanceBodies.Num() == 0);
+	check(InstanceBodies.Num() == Instances.Num());
 
-	FPhysScene* PhysicsScene = GetWorld()->GetPhysicsScene();
-	if (!PhysicsScene)
+	if (NumPendingInstances == 0)
 	{
-		return;
+		return true;
 	}
+	if (Budget <= 0)
+	{
+		return false;
+	}
+
+	// Bodies are kept a bit further than the invoker radius to avoid thrashing at the boundary
+	constexpr float ReleaseRadiusMultiplier = 1.2f;
 
+	const FBox ComponentBounds = Bounds.GetBox();
+	const bool bHasInvokers = Invokers.Num() > 0;
+
+	bool bInRange = !bHasInvokers;
+	for (const FSphere& Invoker : Invokers)
+	{
+		if (FMath::SphereAABBIntersection(Invoker.Center, FMath::Square(Invoker.W * ReleaseRadiusMultiplier), ComponentBounds))
+		{
+			bInRange = true;
+			break;
+		}
+	}
+
+	if (!bInRange &&
+		NumInstanceBodies == 0)
+	{
+		NumPendingInstances = 0;
+		return true;
+	}
+
+	FPhysScene* PhysicsScene = GetWorld()->GetPhysicsScene();
 	UBodySetup* BodySetup = GetBodySetup();
-	if (!BodySetup)
+	if (!PhysicsScene ||
+		!BodySetup)
 	{
-		InstanceBodies.AddZeroed(Instances.Num());
-		return;
+		NumPendingInstances = 0;
+		return true;
 	}
 
 	if (!BodyInstance.GetOverrideWalkableSlopeOnInstance())
@@ -118,40 +151,114 @@ void UVoxelFoliageCollisionComponent::CreateAllInstanceBodies()
 		BodyInstance.SetWalkableSlopeOverride(BodySetup->WalkableSlopeOverride, false);
 	}
 
-	InstanceBodies.Reserve(Instances.Num());
-	InstanceBodies.SetNumUninitialized(Instances.Num());
+	const FTransform ComponentTransform = GetComponentTransform();
 
-	TArray<FBodyInstance*> ValidBodyInstances;
-	ValidBodyInstances.Reserve(Instances.Num());
-	TArray<FTransform> ValidTransforms;
-	ValidTransforms.Reserve(Instances.Num());
+	TArray<FBodyInstance*> NewBodyInstances;
+	TArray<FTransform> NewTransforms;
+	bool bReleasedBodies = false;
 
-	for (int32 Index = 0; Index < Instances.Num(); Index++)
+	while (NumPendingInstances > 0 && Budget > 0)
 	{
-		const FTransform InstanceTransform = FTransform(Instances[Index]) * GetComponentTransform();
+		const int32 Index = UpdateCursor;
+		UpdateCursor = (UpdateCursor + 1) % Instances.Num();
+		NumPendingInstances--;
+
+		FBodyInstance*& InstanceBody = InstanceBodies[Index];
+
+		bool bWantsBody = !bHasInvokers;
+		if (bInRange &&
+			bHasInvokers)
+		{
+			const FVector Position = ComponentTransform.TransformPosition(Instances[Index].GetOrigin());
+			const float RadiusMultiplier = InstanceBody ? ReleaseRadiusMultiplier : 1.f;
 
+			for (const FSphere& Invoker : Invokers)
+			{
+				if (FVector::DistSquared(Position, Invoker.Center) <= FMath::Square(Invoker.W * RadiusMultiplier))
+				{
+					bWantsBody = true;
+					break;
+				}
+			}
+		}
+
+		if (bWantsBody == (InstanceBody != nullptr))
+		{
+			continue;
+		}
+
+		if (!bWantsBody)
+		{
+			InstanceBody->TermBody();
+			BodyPool.Add(InstanceBody);
+			InstanceBody = nullptr;
+
+			NumInstanceBodies--;
+			Budget--;
+			bReleasedBodies = true;
+			continue;
+		}
+
+		const FTransform InstanceTransform = FTransform(Instances[Index]) * ComponentTransform;
 		if (InstanceTransform.GetScale3D().IsNearlyZero())
 		{
-			InstanceBodies[Index] = nullptr;
 			continue;
 		}
 
-		FBodyInstance* Instance = new FBodyInstance();
+		FBodyInstance* Instance = BodyPool.Num() > 0 ? BodyPool.Pop(false) : new FBodyInstance();
 
-		InstanceBodies[Index] = Instance;
+		InstanceBody = Instance;
 		Instance->CopyRuntimeBodyInstancePropertiesFrom(&BodyInstance);
 		Instance->InstanceBodyIndex = Index;
 		Instance->bAutoWeld = false;
 
 		Instance->bSimulatePhysics = false;
 
-		ValidBodyInstances.Add(Instance);
-		ValidTransforms.Add(InstanceTransform);
+		NewBodyInstances.Add(Instance);
+		NewTransforms.Add(InstanceTransform);
+
+		NumInstanceBodies++;
+		Budget--;
+	}
+
+	if (NewBodyInstances.Num() > 0)
+	{
+		FBodyInstance::InitStaticBodies(NewBodyInstances, NewTransforms, BodySetup, this, PhysicsScene);
+	}
+
+	if (NewBodyInstances.Num() > 0 ||
+		bReleasedBodies)
+	{
+		// Recreating the physics state would terminate the instance bodies, only do it if it was never created
+		if (!IsPhysicsStateCreated())
+		{
+			RecreatePhysicsState();
+		}
+		else
+		{
+			UE_501_ONLY(OnComponentPhysicsStateChanged.Broadcast(this, EComponentPhysicsStateChange::Created);)
+		}
+		MarkRenderStateDirty();
+	}
+
+	return NumPendingInstances == 0;
+}
+
+void UVoxelFoliageCollisionComponent::ReleaseAllInstanceBodies(TArray<FBodyInstance*>& BodyPool)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	for (FBodyInstance*& InstanceBody : InstanceBodies)
+	{
+		if (InstanceBody)
+		{
+			InstanceBody->TermBody();
+			BodyPool.Add(InstanceBody);
+			InstanceBody = nullptr;
+		}
 	}
 
-	FBodyInstance::InitStaticBodies(ValidBodyInstances, ValidTransforms, BodySetup, this, PhysicsScene);
-	RecreatePhysicsState();
-	MarkRenderStateDirty();
+	NumInstanceBodies = 0;
 }
 
 void UVoxelFoliageCollisionComponent::ClearAllInstanceBodies()
@@ -169,6 +276,9 @@ void UVoxelFoliageCollisionComponent::ClearAllInstanceBodies()
 
 	InstanceBodies.Reset();
 	Instances.Reset();
+	NumInstanceBodies = 0;
+	UpdateCursor = 0;
+	NumPendingInstances = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,44 @@
+﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
+
+#include "Collision/VoxelFoliageCollisionInvokerComponent.h"
+
+TArray<TWeakObjectPtr<UVoxelFoliageCollisionInvokerComponent>> GVoxelFoliageCollisionInvokers;
+
+void UVoxelFoliageCollisionInvokerComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	check(IsInGameThread());
+	GVoxelFoliageCollisionInvokers.AddUnique(this);
+}
+
+void UVoxelFoliageCollisionInvokerComponent::OnUnregister()
+{
+	check(IsInGameThread());
+	GVoxelFoliageCollisionInvokers.RemoveSwap(this);
+
+	Super::OnUnregister();
+}
+
+void UVoxelFoliageCollisionInvokerComponent::GetInvokers(const UWorld* World, TArray<FSphere>& OutInvokers)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInGameThread());
+
+	GVoxelFoliageCollisionInvokers.RemoveAllSwap([](const TWeakObjectPtr<UVoxelFoliageCollisionInvokerComponent>& Invoker)
+	{
+		return !Invoker.IsValid();
+	});
+
+	for (const TWeakObjectPtr<UVoxelFoliageCollisionInvokerComponent>& WeakInvoker : GVoxelFoliageCollisionInvokers)
+	{
+		const UVoxelFoliageCollisionInvokerComponent* Invoker = WeakInvoker.Get();
+		if (!ensure(Invoker) ||
+			Invoker->GetWorld() != World)
+		{
+			continue;
+		}
+
+		OutInvokers.Add(FSphere(Invoker->GetComponentLocation(), Invoker->Radius));
+	}
+}
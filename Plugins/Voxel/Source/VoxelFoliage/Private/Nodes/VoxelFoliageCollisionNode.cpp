@@ -42,6 +42,16 @@ void FVoxelChunkExecObject_CreateFoliageCollision::Destroy(FVoxelRuntime& Runtim
 	CollisionIds = {};
 }
 
+int64 FVoxelChunkExecObject_CreateFoliageCollision::GetAllocatedSize() const
+{
+	int64 AllocatedSize = Super::GetAllocatedSize() + TemplatesData.GetAllocatedSize();
+	for (const FVoxelFoliageCollisionData& Data : TemplatesData)
+	{
+		AllocatedSize += Data.FoliageData ? Data.FoliageData->GetAllocatedSize() : 0;
+	}
+	return AllocatedSize;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
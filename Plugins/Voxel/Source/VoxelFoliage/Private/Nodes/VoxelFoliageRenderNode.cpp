@@ -21,12 +21,19 @@ void FVoxelChunkExecObject_CreateFoliageMeshComponent::Create(FVoxelRuntime& Run
 			continue;
 		}
 
-		FoliageIds.Add(FoliageRenderer.CreateMesh(
+		const FVoxelFoliageRendererId Id = FoliageRenderer.CreateMesh(
 			Position,
 			Data.StaticMesh.Get(),
 			Data.FoliageSettings,
-			Data.FoliageData.ToSharedRef()));
+			Data.FoliageData.ToSharedRef(),
+			Dependency);
+
+		FoliageIds.Add(Id);
+		RendererAllocatedSize += FoliageRenderer.GetAllocatedSize(Id);
 	}
+
+	// The renderer may have thinned the instances out, don't keep the full data alive
+	VOXEL_CONST_CAST(TemplatesData).Empty();
 }
 
 void FVoxelChunkExecObject_CreateFoliageMeshComponent::Destroy(FVoxelRuntime& Runtime) const
@@ -40,6 +47,17 @@ void FVoxelChunkExecObject_CreateFoliageMeshComponent::Destroy(FVoxelRuntime& Ru
 	}
 
 	FoliageIds = {};
+	RendererAllocatedSize = 0;
+}
+
+int64 FVoxelChunkExecObject_CreateFoliageMeshComponent::GetAllocatedSize() const
+{
+	int64 AllocatedSize = Super::GetAllocatedSize() + TemplatesData.GetAllocatedSize() + RendererAllocatedSize;
+	for (const FTemplateData& Data : TemplatesData)
+	{
+		AllocatedSize += Data.FoliageData ? Data.FoliageData->GetAllocatedSize() : 0;
+	}
+	return AllocatedSize;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -180,6 +198,8 @@ TVoxelFutureValue<FVoxelChunkExecObject> FVoxelChunkExecNode_CreateFoliageMeshCo
 		return {};
 	}
 
+	Object->Dependency = Query.AllocateDependency();
+
 	return VOXEL_ON_COMPLETE(GameThread, Object)
 	{
 		struct FFoliageMeshData
@@ -55,6 +55,56 @@ void UVoxelFoliageComponent::StartTreeBuild()
 	});
 }
 
+void UVoxelFoliageComponent::StartTreeBuild(TFunction<TSharedRef<const FVoxelFoliageData>()> GetFoliageData)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (!GetStaticMesh())
+	{
+		return;
+	}
+
+	QueuedTreeId = FVoxelFoliageComponentTreeId::New();
+
+	AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [
+		WeakThis = MakeWeakObjectPtr(this),
+		TreeId = QueuedTreeId,
+		MeshBox = GetStaticMesh()->GetBounds().GetBox(),
+		InDesiredInstancesPerLeaf = DesiredInstancesPerLeaf(),
+		GetFoliageData = MoveTemp(GetFoliageData)]
+	{
+		const TSharedRef<const FVoxelFoliageData> NewFoliageData = GetFoliageData();
+
+		const TSharedRef<FVoxelFoliageBuiltData> BuiltData = MakeShared<FVoxelFoliageBuiltData>();
+		if (NewFoliageData->Transforms->Num() > 0)
+		{
+			AsyncTreeBuild(*BuiltData, MeshBox, InDesiredInstancesPerLeaf, *NewFoliageData);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [=]
+		{
+			UVoxelFoliageComponent* This = WeakThis.Get();
+			if (!This ||
+				This->QueuedTreeId != TreeId)
+			{
+				return;
+			}
+
+			This->QueuedTreeId = {};
+
+			if (NewFoliageData->Transforms->Num() == 0)
+			{
+				This->ClearInstances();
+				return;
+			}
+
+			This->FoliageData = NewFoliageData;
+			This->FoliageData->UpdateStats();
+			This->FinishTreeBuild(MoveTemp(*BuiltData));
+		});
+	});
+}
+
 void UVoxelFoliageComponent::ClearInstances()
 {
 	VOXEL_FUNCTION_COUNTER();
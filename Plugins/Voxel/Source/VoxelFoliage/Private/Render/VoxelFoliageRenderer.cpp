@@ -3,11 +3,22 @@
 #include "Render/VoxelFoliageRenderer.h"
 #include "Render/VoxelFoliageComponent.h"
 #include "VoxelFoliageComponentPool.h"
+#include "VoxelQuery.h"
 
 VOXEL_CONSOLE_VARIABLE(
 	VOXELFOLIAGE_API, int32, GVoxelFoliageMaxInstances, 10 * 1000 * 1000,
 	"voxel.foliage.MaxInstances",
-	"");
+	"Max number of foliage instances rendered. Once reached, the chunks with the smallest screen size are thinned out");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELFOLIAGE_API, float, GVoxelFoliageBudgetRefreshDistance, 1000.f,
+	"voxel.foliage.BudgetRefreshDistance",
+	"Distance the camera needs to move before the foliage instance budget is reallocated");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELFOLIAGE_API, float, GVoxelFoliageRenderRegionSize, 25600.f,
+	"voxel.foliage.RenderRegionSize",
+	"Foliage instances of the same mesh & settings within a region of this size are merged into a single component. 0 to disable");
 
 DEFINE_UNIQUE_VOXEL_ID(FVoxelFoliageRendererId);
 DEFINE_VOXEL_SUBSYSTEM(FVoxelFoliageRenderer);
@@ -16,7 +27,8 @@ FVoxelFoliageRendererId FVoxelFoliageRenderer::CreateMesh(
 	const FVector3d& Position,
 	UStaticMesh* Mesh,
 	const FVoxelFoliageSettings& FoliageSettings,
-	const TSharedRef<const FVoxelFoliageData>& FoliageData)
+	const TSharedRef<const FVoxelFoliageData>& FoliageData,
+	const TSharedPtr<FVoxelDependency>& Dependency)
 {
 	VOXEL_FUNCTION_COUNTER();
 
@@ -24,41 +36,451 @@ FVoxelFoliageRendererId FVoxelFoliageRenderer::CreateMesh(
 
 	const FVoxelFoliageRendererId Id = FVoxelFoliageRendererId::New();
 
-	TWeakObjectPtr<UVoxelFoliageComponent>& Component = Components.Add(Id);
-	Component = GetSubsystem<FVoxelFoliageComponentPool>().CreateComponent(Position);
-	Component->SetStaticMesh(Mesh);
+	FIntVector Region = FIntVector(MAX_int32);
+	if (GVoxelFoliageRenderRegionSize > 0.f)
+	{
+		Region = FVoxelUtilities::FloorToInt(Position / GVoxelFoliageRenderRegionSize);
+	}
+
+	const FBucketKey Key{ Mesh, Region, FoliageData->CustomDatas.Num() };
+	TArray<TSharedPtr<FBucket>>& RegionBuckets = Buckets.FindOrAdd(Key);
 
-	FoliageSettings.ApplyToComponent(*Component);
+	TSharedPtr<FBucket> Bucket;
+	if (Region != FIntVector(MAX_int32))
+	{
+		for (const TSharedPtr<FBucket>& OtherBucket : RegionBuckets)
+		{
+			if (FVoxelFoliageSettings::StaticStruct()->CompareScriptStruct(&OtherBucket->FoliageSettings, &FoliageSettings, PPF_None))
+			{
+				Bucket = OtherBucket;
+				break;
+			}
+		}
+	}
+
+	if (!Bucket)
+	{
+		Bucket = MakeShared<FBucket>();
+		Bucket->Key = Key;
+		Bucket->Origin = Position;
+		Bucket->Mesh = Mesh;
+		Bucket->FoliageSettings = FoliageSettings;
+		RegionBuckets.Add(Bucket);
+	}
+
+	FBucket::FChunk& Chunk = Bucket->Chunks.Add(Id);
+	Chunk.Position = Position;
+	Chunk.NumInstances = FoliageData->Transforms->Num();
+	Chunk.Dependency = Dependency;
+	for (const FTransform3f& Transform : *FoliageData->Transforms)
+	{
+		Chunk.Bounds += Transform.GetTranslation();
+	}
+
+	// Without a dependency the chunk can't be regenerated, so all its instances need to be kept
+	if (Dependency &&
+		LastCameraPosition != FVector(MAX_dbl))
+	{
+		Chunk.Density = GetDensity(BudgetScale, GetImportance(LastCameraPosition, Chunk));
+	}
+	Chunk.StoredDensity = Chunk.Density;
 
-	if (NumInstances + FoliageData->Transforms->Num() > GVoxelFoliageMaxInstances)
+	if (Chunk.Density < 1.f)
 	{
-		VOXEL_MESSAGE(Error, "More than {0} foliage instances being rendered, aborting", GVoxelFoliageMaxInstances);
+		VOXEL_SCOPE_COUNTER("Thin out");
+
+		const TSharedRef<FVoxelFoliageData> ThinnedData = MakeShared<FVoxelFoliageData>();
+		ThinnedData->Transforms = MakeShared<TVoxelArray<FTransform3f>>();
+		ThinnedData->CustomDatas.SetNum(FoliageData->CustomDatas.Num());
+
+		for (int32 InstanceIndex = 0; InstanceIndex < FoliageData->Transforms->Num(); InstanceIndex++)
+		{
+			const FTransform3f& Transform = (*FoliageData->Transforms)[InstanceIndex];
+			if (!IsInstanceKept(Transform, Chunk.Density))
+			{
+				continue;
+			}
+
+			ThinnedData->Transforms->Add(Transform);
+
+			for (int32 Index = 0; Index < FoliageData->CustomDatas.Num(); Index++)
+			{
+				ThinnedData->CustomDatas[Index].Add(FoliageData->CustomDatas[Index][InstanceIndex]);
+			}
+		}
+
+		ThinnedData->Transforms->Shrink();
+		for (TVoxelArray<float>& CustomData : ThinnedData->CustomDatas)
+		{
+			CustomData.Shrink();
+		}
+		ThinnedData->UpdateStats();
+
+		Chunk.FoliageData = ThinnedData;
 	}
 	else
 	{
-		NumInstances += FoliageData->Transforms->Num();
-		Component->FoliageData = FoliageData;
-		Component->StartTreeBuild();
+		Chunk.FoliageData = FoliageData;
 	}
 
+	Bucket->bIsDirty = true;
+	IdToBucket.Add(Id, Bucket);
+	bBudgetDirty = true;
+
 	return Id;
 }
 
 void FVoxelFoliageRenderer::DestroyMesh(FVoxelFoliageRendererId Id)
 {
-	TWeakObjectPtr<UVoxelFoliageComponent> Component;
+	TSharedPtr<FBucket> Bucket;
 	if (IsDestroyed() ||
-		!ensure(Components.RemoveAndCopyValue(Id, Component)) ||
-		!Component.IsValid())
+		!ensure(IdToBucket.RemoveAndCopyValue(Id, Bucket)) ||
+		!ensure(Bucket->Chunks.Remove(Id)))
+	{
+		return;
+	}
+
+	bBudgetDirty = true;
+
+	if (Bucket->Chunks.Num() == 0)
+	{
+		RemoveBucket(Bucket);
+		return;
+	}
+
+	Bucket->bIsDirty = true;
+}
+
+int64 FVoxelFoliageRenderer::GetAllocatedSize(const FVoxelFoliageRendererId Id) const
+{
+	const TSharedPtr<FBucket> Bucket = IdToBucket.FindRef(Id);
+	if (!Bucket)
+	{
+		return 0;
+	}
+
+	const FBucket::FChunk* Chunk = Bucket->Chunks.Find(Id);
+	if (!ensure(Chunk))
+	{
+		return 0;
+	}
+
+	return Chunk->FoliageData->GetAllocatedSize();
+}
+
+void FVoxelFoliageRenderer::Tick()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	Super::Tick();
+
+	UpdateBudget();
+
+	// Changes are batched per frame so that chunks streaming in the same region only trigger a single tree build
+	for (const auto& It : Buckets)
+	{
+		for (const TSharedPtr<FBucket>& Bucket : It.Value)
+		{
+			if (Bucket->bIsDirty)
+			{
+				Bucket->bIsDirty = false;
+				UpdateBucket(*Bucket);
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelFoliageRenderer::UpdateBudget()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	FVector CameraPosition = LastCameraPosition;
+	if (FVoxelGameUtilities::GetCameraView(GetWorld(), CameraPosition))
+	{
+		CameraPosition = WorldToLocal().TransformPosition(CameraPosition);
+	}
+	else if (LastCameraPosition == FVector(MAX_dbl))
+	{
+		// No camera yet, importances would all be zero: keep bBudgetDirty set until there is one
+		return;
+	}
+
+	if (!bBudgetDirty &&
+		FVector::Distance(CameraPosition, LastCameraPosition) < GVoxelFoliageBudgetRefreshDistance)
+	{
+		return;
+	}
+	bBudgetDirty = false;
+	LastCameraPosition = CameraPosition;
+
+	struct FChunkInfo
+	{
+		FBucket* Bucket = nullptr;
+		FBucket::FChunk* Chunk = nullptr;
+		int32 Num = 0;
+		// Approximate screen size
+		double Importance = 0.;
+	};
+	TArray<FChunkInfo> ChunkInfos;
+	int64 TotalNum = 0;
+
+	for (const auto& It : Buckets)
+	{
+		for (const TSharedPtr<FBucket>& Bucket : It.Value)
+		{
+			for (auto& ChunkIt : Bucket->Chunks)
+			{
+				FChunkInfo& ChunkInfo = ChunkInfos.Emplace_GetRef();
+				ChunkInfo.Bucket = Bucket.Get();
+				ChunkInfo.Chunk = &ChunkIt.Value;
+				ChunkInfo.Num = ChunkIt.Value.NumInstances;
+				ChunkInfo.Importance = GetImportance(CameraPosition, ChunkIt.Value);
+
+				TotalNum += ChunkInfo.Num;
+			}
+		}
+	}
+
+	// Density of a chunk is Min(1, Scale * Importance), find the largest Scale fitting in the budget
+	double Scale = MAX_flt;
+	if (TotalNum > GVoxelFoliageMaxInstances)
+	{
+		VOXEL_SCOPE_COUNTER("Find scale");
+
+		const auto GetNum = [&](const double TestScale)
+		{
+			double Num = 0.;
+			for (const FChunkInfo& ChunkInfo : ChunkInfos)
+			{
+				Num += ChunkInfo.Num * FMath::Min(1., TestScale * ChunkInfo.Importance);
+			}
+			return Num;
+		};
+
+		double Min = 0.;
+		double Max = 1.;
+		while (GetNum(Max) < GVoxelFoliageMaxInstances)
+		{
+			Max *= 2.;
+		}
+
+		for (int32 Iteration = 0; Iteration < 32; Iteration++)
+		{
+			const double Mid = (Min + Max) / 2.;
+			if (GetNum(Mid) <= GVoxelFoliageMaxInstances)
+			{
+				Min = Mid;
+			}
+			else
+			{
+				Max = Mid;
+			}
+		}
+		Scale = Min;
+	}
+	BudgetScale = Scale;
+
+	TSet<TSharedPtr<FVoxelDependency>> DependenciesToInvalidate;
+	for (const FChunkInfo& ChunkInfo : ChunkInfos)
+	{
+		FBucket::FChunk& Chunk = *ChunkInfo.Chunk;
+		const float Density = GetDensity(Scale, ChunkInfo.Importance);
+
+		// The instances above StoredDensity were discarded: regenerate the chunk once it should render at least twice as many
+		if (Density >= FMath::Min(2.f * Chunk.StoredDensity, 1.f) &&
+			Density > Chunk.StoredDensity &&
+			Chunk.Dependency &&
+			!Chunk.Dependency->IsInvalidated())
+		{
+			DependenciesToInvalidate.Add(Chunk.Dependency);
+		}
+
+		const float RenderedDensity = FMath::Min(Density, Chunk.StoredDensity);
+		if (Chunk.Density != RenderedDensity)
+		{
+			Chunk.Density = RenderedDensity;
+			ChunkInfo.Bucket->bIsDirty = true;
+		}
+	}
+
+	if (DependenciesToInvalidate.Num() > 0)
+	{
+		FVoxelDependency::InvalidateDependencies(DependenciesToInvalidate);
+	}
+}
+
+double FVoxelFoliageRenderer::GetImportance(const FVector& CameraPosition, const FBucket::FChunk& Chunk)
+{
+	// Approximate screen size
+	const FVector Center = Chunk.Position + FVector(Chunk.Bounds.GetCenter());
+	const double Radius = FMath::Max(Chunk.Bounds.GetExtent().Size(), 1.f);
+	return Radius / FMath::Max(FVector::Distance(CameraPosition, Center), Radius);
+}
+
+float FVoxelFoliageRenderer::GetDensity(const double Scale, const double Importance)
+{
+	const double Density = FMath::Min(1., Scale * Importance);
+	if (Density <= 0.)
+	{
+		return 0.f;
+	}
+
+	// Quantize to avoid rebuilding buckets on every small camera move
+	// Distant chunks keep at least one step instead of disappearing
+	constexpr float NumSteps = 32.f;
+	return FMath::Max(FMath::RoundToFloat(float(Density) * NumSteps), 1.f) / NumSteps;
+}
+
+bool FVoxelFoliageRenderer::IsInstanceKept(const FTransform3f& Transform, const float Density)
+{
+	const uint32 Hash = uint32(FVoxelUtilities::MurmurHash(Transform.GetTranslation()));
+	return Hash / float(MAX_uint32) < Density;
+}
+
+void FVoxelFoliageRenderer::UpdateBucket(FBucket& Bucket)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(Bucket.Chunks.Num() > 0);
+
+	UStaticMesh* Mesh = Bucket.Mesh.Get();
+	if (!Mesh)
 	{
 		return;
 	}
 
-	if (ensure(Component->FoliageData))
+	if (!Bucket.Component.IsValid())
+	{
+		UVoxelFoliageComponent* Component = GetSubsystem<FVoxelFoliageComponentPool>().CreateComponent(Bucket.Origin);
+		if (!ensure(Component))
+		{
+			return;
+		}
+
+		Component->SetStaticMesh(Mesh);
+		Bucket.FoliageSettings.ApplyToComponent(*Component);
+		Bucket.Component = Component;
+	}
+
+	if (Bucket.Chunks.Num() == 1 &&
+		Bucket.Chunks.CreateConstIterator().Value().Position == Bucket.Origin &&
+		Bucket.Chunks.CreateConstIterator().Value().Density == Bucket.Chunks.CreateConstIterator().Value().StoredDensity)
+	{
+		const TSharedPtr<const FVoxelFoliageData> FoliageData = Bucket.Chunks.CreateConstIterator().Value().FoliageData;
+		if (FoliageData->Transforms->Num() == 0)
+		{
+			Bucket.Component->ClearInstances();
+			return;
+		}
+
+		// Use the chunk data as-is, along with its prebuilt tree if any
+		Bucket.Component->FoliageData = FoliageData;
+		Bucket.Component->StartTreeBuild();
+		return;
+	}
+
+	struct FChunkToMerge
+	{
+		FVector3f Offset = FVector3f(ForceInit);
+		float Density = 1.f;
+		TSharedPtr<const FVoxelFoliageData> FoliageData;
+	};
+	TArray<FChunkToMerge> ChunksToMerge;
+	ChunksToMerge.Reserve(Bucket.Chunks.Num());
+	for (const auto& It : Bucket.Chunks)
+	{
+		// The stored data is already thinned out to StoredDensity
+		ChunksToMerge.Add(
+		{
+			FVector3f(It.Value.Position - Bucket.Origin),
+			It.Value.Density < It.Value.StoredDensity ? It.Value.Density : 1.f,
+			It.Value.FoliageData
+		});
+	}
+
+	// Merging can copy millions of instances, do it in the tree build task
+	Bucket.Component->StartTreeBuild([ChunksToMerge = MoveTemp(ChunksToMerge)]() -> TSharedRef<const FVoxelFoliageData>
+	{
+		VOXEL_SCOPE_COUNTER("Merge chunks");
+
+		int32 Num = 0;
+		int32 NumCustomDatas = 0;
+		for (const FChunkToMerge& Chunk : ChunksToMerge)
+		{
+			Num += Chunk.FoliageData->Transforms->Num();
+			NumCustomDatas = Chunk.FoliageData->CustomDatas.Num();
+		}
+
+		const TSharedRef<FVoxelFoliageData> MergedData = MakeShared<FVoxelFoliageData>();
+		MergedData->Transforms = MakeShared<TVoxelArray<FTransform3f>>();
+		MergedData->Transforms->Reserve(Num);
+		MergedData->CustomDatas.SetNum(NumCustomDatas);
+		for (TVoxelArray<float>& CustomData : MergedData->CustomDatas)
+		{
+			CustomData.Reserve(Num);
+		}
+
+		for (const FChunkToMerge& Chunk : ChunksToMerge)
+		{
+			const FVoxelFoliageData& ChunkData = *Chunk.FoliageData;
+
+			if (Chunk.Density >= 1.f)
+			{
+				for (FTransform3f Transform : *ChunkData.Transforms)
+				{
+					Transform.AddToTranslation(Chunk.Offset);
+					MergedData->Transforms->Add(Transform);
+				}
+
+				for (int32 Index = 0; Index < NumCustomDatas; Index++)
+				{
+					MergedData->CustomDatas[Index].Append(ChunkData.CustomDatas[Index]);
+				}
+				continue;
+			}
+
+			for (int32 InstanceIndex = 0; InstanceIndex < ChunkData.Transforms->Num(); InstanceIndex++)
+			{
+				FTransform3f Transform = (*ChunkData.Transforms)[InstanceIndex];
+				if (!IsInstanceKept(Transform, Chunk.Density))
+				{
+					continue;
+				}
+
+				Transform.AddToTranslation(Chunk.Offset);
+				MergedData->Transforms->Add(Transform);
+
+				for (int32 Index = 0; Index < NumCustomDatas; Index++)
+				{
+					MergedData->CustomDatas[Index].Add(ChunkData.CustomDatas[Index][InstanceIndex]);
+				}
+			}
+		}
+
+		return MergedData;
+	});
+}
+
+void FVoxelFoliageRenderer::RemoveBucket(const TSharedPtr<FBucket>& Bucket)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	TArray<TSharedPtr<FBucket>>* RegionBuckets = Buckets.Find(Bucket->Key);
+	if (ensure(RegionBuckets))
 	{
-		NumInstances -= Component->FoliageData->Transforms->Num();
-		ensure(NumInstances >= 0);
+		ensure(RegionBuckets->RemoveSwap(Bucket) == 1);
+
+		if (RegionBuckets->Num() == 0)
+		{
+			Buckets.Remove(Bucket->Key);
+		}
 	}
 
-	GetSubsystem<FVoxelFoliageComponentPool>().DestroyComponent(Component.Get());
-}
\ No newline at end of file
+	if (Bucket->Component.IsValid())
+	{
+		GetSubsystem<FVoxelFoliageComponentPool>().DestroyComponent(Bucket->Component.Get());
+	}
+}
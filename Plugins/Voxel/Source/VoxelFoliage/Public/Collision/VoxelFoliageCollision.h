@@ -23,6 +23,11 @@ class VOXELFOLIAGE_API FVoxelFoliageCollision : public IVoxelSubsystem
 public:
 	GENERATED_VOXEL_SUBSYSTEM_BODY(UVoxelFoliageCollisionProxy);
 
+	//~ Begin IVoxelSubsystem Interface
+	virtual void Destroy() override;
+	virtual void Tick() override;
+	//~ End IVoxelSubsystem Interface
+
 	FVoxelFoliageCollisionId CreateMesh(
 		const FVector3d& Position,
 		UStaticMesh* Mesh,
@@ -34,4 +39,12 @@ public:
 private:
 	int32 NumInstances = 0;
 	TMap<FVoxelFoliageCollisionId, TWeakObjectPtr<UVoxelFoliageCollisionComponent>> Components;
+	TArray<FBodyInstance*> BodyPool;
+
+	// Invokers used by the last rescan
+	TArray<FSphere> Invokers;
+	// Components with instances left to update, in order
+	TArray<FVoxelFoliageCollisionId> PendingComponents;
+
+	bool HaveInvokersMoved(TConstArrayView<FSphere> NewInvokers) const;
 };
\ No newline at end of file
@@ -36,7 +36,16 @@ public:
 	int32 GetInstancesCount() const { return Instances.Num(); }
 
 public:
-	void CreateAllInstanceBodies();
+	// Starts a new pass over all the instances, eg when the invokers moved
+	void MarkPendingUpdate()
+	{
+		NumPendingInstances = Instances.Num();
+	}
+	// Creates the bodies of the pending instances within range of Invokers (or of all instances if there are none),
+	// and releases the ones out of range. Each body created or released consumes one unit of Budget
+	// Returns true once there are no pending instances left
+	bool UpdateInstanceBodies(TConstArrayView<FSphere> Invokers, int32& Budget, TArray<FBodyInstance*>& BodyPool);
+	void ReleaseAllInstanceBodies(TArray<FBodyInstance*>& BodyPool);
 	void ClearAllInstanceBodies();
 
 	//~ Begin UPrimitiveComponent Interface.
@@ -49,6 +58,11 @@ private:
 
 	TArray<FMatrix> Instances;
 	TArray<FBodyInstance*> InstanceBodies;
+	int32 NumInstanceBodies = 0;
+
+	// Instances are visited round-robin, so that a pass running out of budget resumes where it stopped
+	int32 UpdateCursor = 0;
+	int32 NumPendingInstances = 0;
 
 	friend class FVoxelFoliageCollisionSceneProxy;
 };
\ No newline at end of file
@@ -0,0 +1,26 @@
+﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "VoxelMinimal.h"
+#include "VoxelFoliageCollisionInvokerComponent.generated.h"
+
+// Foliage collision bodies are only created around invokers (players, AI, projectiles...)
+// If no invoker is registered in the world, all foliage instances get a body
+UCLASS(BlueprintType, Blueprintable, ClassGroup = (Voxel), meta = (BlueprintSpawnableComponent))
+class VOXELFOLIAGE_API UVoxelFoliageCollisionInvokerComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Foliage instances closer than this will have collision
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel", meta = (ClampMin = 0, Units = cm))
+	float Radius = 2000.f;
+
+	//~ Begin USceneComponent Interface.
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	//~ End USceneComponent Interface.
+
+	static void GetInvokers(const UWorld* World, TArray<FSphere>& OutInvokers);
+};
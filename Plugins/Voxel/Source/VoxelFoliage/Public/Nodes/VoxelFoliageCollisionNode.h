@@ -25,8 +25,10 @@ public:
 	FVector Position = FVector::Zero();
 	TArray<FVoxelFoliageCollisionData> TemplatesData;
 
+	virtual bool IsGameplayRelevant() const override { return true; }
 	virtual void Create(FVoxelRuntime& Runtime) const override;
 	virtual void Destroy(FVoxelRuntime& Runtime) const override;
+	virtual int64 GetAllocatedSize() const override;
 
 private:
 	mutable TSet<FVoxelFoliageCollisionId> CollisionIds;
@@ -24,13 +24,18 @@ public:
 	};
 
 	FVector Position = FVector::Zero();
+	// Released once handed to the renderer, which only keeps the instances it renders
 	TArray<FTemplateData> TemplatesData;
+	// Invalidated by the renderer to regenerate the chunk once it needs more instances than it kept
+	TSharedPtr<FVoxelDependency> Dependency;
 
 	virtual void Create(FVoxelRuntime& Runtime) const override;
 	virtual void Destroy(FVoxelRuntime& Runtime) const override;
+	virtual int64 GetAllocatedSize() const override;
 
 private:
 	mutable TSet<FVoxelFoliageRendererId> FoliageIds;
+	mutable int64 RendererAllocatedSize = 0;
 };
 
 USTRUCT(Category = "Foliage")
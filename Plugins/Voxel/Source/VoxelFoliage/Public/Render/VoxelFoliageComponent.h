@@ -32,6 +32,8 @@ public:
 	UVoxelFoliageComponent();
 
 	void StartTreeBuild();
+	// Computes the foliage data on the background thread before building the tree
+	void StartTreeBuild(TFunction<TSharedRef<const FVoxelFoliageData>()> GetFoliageData);
 	virtual void ClearInstances() override;
 	virtual void DestroyComponent(bool bPromoteChildren) override;
 
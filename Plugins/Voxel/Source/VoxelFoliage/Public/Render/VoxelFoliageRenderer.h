@@ -7,6 +7,7 @@
 #include "VoxelRuntime/VoxelSubsystem.h"
 #include "VoxelFoliageRenderer.generated.h"
 
+class FVoxelDependency;
 class UVoxelFoliageComponent;
 
 DECLARE_UNIQUE_VOXEL_ID(FVoxelFoliageRendererId);
@@ -23,15 +24,64 @@ class VOXELFOLIAGE_API FVoxelFoliageRenderer : public IVoxelSubsystem
 public:
 	GENERATED_VOXEL_SUBSYSTEM_BODY(UVoxelFoliageRendererProxy);
 
+	// Only the instances rendered under the current budget are kept
+	// If set, Dependency is invalidated once the budget needs more instances than were kept
 	FVoxelFoliageRendererId CreateMesh(
 		const FVector3d& Position,
 		UStaticMesh* Mesh,
 		const FVoxelFoliageSettings& FoliageSettings,
-		const TSharedRef<const FVoxelFoliageData>& FoliageData);
+		const TSharedRef<const FVoxelFoliageData>& FoliageData,
+		const TSharedPtr<FVoxelDependency>& Dependency);
 
 	void DestroyMesh(FVoxelFoliageRendererId Id);
 
+	int64 GetAllocatedSize(FVoxelFoliageRendererId Id) const;
+
+	//~ Begin IVoxelSubsystem Interface
+	virtual void Tick() override;
+	//~ End IVoxelSubsystem Interface
+
 private:
-	int32 NumInstances = 0;
-	TMap<FVoxelFoliageRendererId, TWeakObjectPtr<UVoxelFoliageComponent>> Components;
+	using FBucketKey = TTuple<TWeakObjectPtr<UStaticMesh>, FIntVector, int32>;
+
+	// Instances of the same mesh & settings in the same region are rendered by a single component
+	struct FBucket
+	{
+		FBucketKey Key;
+		FVector3d Origin = FVector3d(ForceInit);
+		TWeakObjectPtr<UStaticMesh> Mesh;
+		FVoxelFoliageSettings FoliageSettings;
+		TWeakObjectPtr<UVoxelFoliageComponent> Component;
+
+		struct FChunk
+		{
+			FVector3d Position = FVector3d(ForceInit);
+			FBox3f Bounds = FBox3f(ForceInit);
+			// Number of instances generated, before any thinning
+			int32 NumInstances = 0;
+			// Instances kept, thinned out to StoredDensity
+			TSharedPtr<const FVoxelFoliageData> FoliageData;
+			TSharedPtr<FVoxelDependency> Dependency;
+			float StoredDensity = 1.f;
+			// Fraction of the instances rendered, set by UpdateBudget. Never above StoredDensity
+			float Density = 1.f;
+		};
+		TMap<FVoxelFoliageRendererId, FChunk> Chunks;
+		bool bIsDirty = false;
+	};
+
+	TMap<FBucketKey, TArray<TSharedPtr<FBucket>>> Buckets;
+	TMap<FVoxelFoliageRendererId, TSharedPtr<FBucket>> IdToBucket;
+
+	bool bBudgetDirty = false;
+	FVector LastCameraPosition = FVector(MAX_dbl);
+	double BudgetScale = MAX_flt;
+
+	void UpdateBudget();
+	static double GetImportance(const FVector& CameraPosition, const FBucket::FChunk& Chunk);
+	static float GetDensity(double Scale, double Importance);
+	// Deterministic per instance: a lower density always keeps a subset of the instances of a higher one
+	static bool IsInstanceKept(const FTransform3f& Transform, float Density);
+	void UpdateBucket(FBucket& Bucket);
+	void RemoveBucket(const TSharedPtr<FBucket>& Bucket);
 };
\ No newline at end of file
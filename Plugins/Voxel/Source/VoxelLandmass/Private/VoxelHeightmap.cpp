@@ -24,6 +24,11 @@ void FVoxelHeightmap::Serialize(FArchive& Ar)
 
 	ensure(SizeX * SizeY == Heights.Num());
 
+	if (Ar.IsLoading())
+	{
+		BuildPyramid();
+	}
+
 	UpdateStats();
 }
 
@@ -37,6 +42,79 @@ void FVoxelHeightmap::Initialize(
 	SizeX = NewSizeX;
 	SizeY = NewSizeY;
 	Heights = MoveTemp(NewHeights);
+
+	BuildPyramid();
+	UpdateStats();
+}
+
+FFloatInterval FVoxelHeightmap::GetHeightRange(const FVector2D& Min, const FVector2D& Max) const
+{
+	if (!Pyramid.IsValid())
+	{
+		return FFloatInterval(0.f, 1.f);
+	}
+
+	// Positions are clamped when sampling
+	const FVector2D Size(SizeX - 1, SizeY - 1);
+	const FVector2D ClampedMin = FVoxelUtilities::Clamp(Min, FVector2D::ZeroVector, Size);
+	const FVector2D ClampedMax = FVoxelUtilities::Clamp(Max, FVector2D::ZeroVector, Size);
+
+	// Cells include their last pixel, no need to extend for bilinear interpolation
+	const FFloatInterval Range = Pyramid.GetMinMax(
+		FVoxelUtilities::FloorToInt(ClampedMin / PyramidCellSize),
+		FVoxelUtilities::FloorToInt(ClampedMax / PyramidCellSize));
+
+	return FFloatInterval(Range.Min / MAX_uint16, Range.Max / MAX_uint16);
+}
+
+FFloatInterval FVoxelHeightmap::GetHeightRange() const
+{
+	if (!Pyramid.IsValid())
+	{
+		return FFloatInterval(0.f, 1.f);
+	}
+
+	const FFloatInterval Range = Pyramid.GetGlobalMinMax();
+	return FFloatInterval(Range.Min / MAX_uint16, Range.Max / MAX_uint16);
+}
+
+void FVoxelHeightmap::BuildPyramid()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (SizeX <= 0 ||
+		SizeY <= 0 ||
+		!ensure(SizeX * SizeY == Heights.Num()))
+	{
+		Pyramid = {};
+		return;
+	}
+
+	const FIntPoint NumCells(
+		FVoxelUtilities::DivideCeil_Positive(SizeX, PyramidCellSize),
+		FVoxelUtilities::DivideCeil_Positive(SizeY, PyramidCellSize));
+
+	Pyramid.Initialize(NumCells, [&](const int32 CellX, const int32 CellY)
+	{
+		// Overlap the next cell by one pixel so that interpolated heights are inside the range
+		const int32 MinX = CellX * PyramidCellSize;
+		const int32 MinY = CellY * PyramidCellSize;
+		const int32 MaxX = FMath::Min(MinX + PyramidCellSize, SizeX - 1);
+		const int32 MaxY = FMath::Min(MinY + PyramidCellSize, SizeY - 1);
+
+		uint16 MinHeight = MAX_uint16;
+		uint16 MaxHeight = 0;
+		for (int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			for (int32 X = MinX; X <= MaxX; X++)
+			{
+				const uint16 Height = Heights[GetIndex(X, Y)];
+				MinHeight = FMath::Min(MinHeight, Height);
+				MaxHeight = FMath::Max(MaxHeight, Height);
+			}
+		}
+		return FFloatInterval(MinHeight, MaxHeight);
+	});
 }
 
 TSharedRef<FVoxelRDGExternalBuffer> FVoxelHeightmap::GetHeights_RenderThread() const
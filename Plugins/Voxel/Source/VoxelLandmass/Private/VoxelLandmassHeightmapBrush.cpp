@@ -53,12 +53,61 @@ FVoxelLandmassHeightmapBrushImpl::FVoxelLandmassHeightmapBrushImpl(const FVoxelL
 	ScaleZ = Transform.GetScale3D().Z;
 	OffsetZ = Transform.GetTranslation().Z;
 	
-	const FVoxelBox2D Bounds(
+	const FVoxelBox2D Bounds = FVoxelBox2D(
 		-FVector2d(Heightmap->GetSizeX(), Heightmap->GetSizeY()) / 2,
-		FVector2d(Heightmap->GetSizeX(), Heightmap->GetSizeY()) / 2);
+		FVector2d(Heightmap->GetSizeX(), Heightmap->GetSizeY()) / 2).Scale(Scale).TransformBy(Rotation).ShiftBy(Position);
 
-	// TODO Compute proper Z bounds
-	SetBounds(Bounds.Scale(Scale).TransformBy(Rotation).ShiftBy(Position).ToBox3D(-1e50, 1e50));
+	// Everything below the surface is inside the brush
+	SetBounds(Bounds.ToBox3D(-1e50, GetHeightRange(Bounds).Max));
+}
+
+FVoxelBox2D FVoxelLandmassHeightmapBrushImpl::GetPixelBounds(const FVoxelBox2D& LocalBounds) const
+{
+	// Same logic as the ISPC kernel
+	return LocalBounds
+		.ShiftBy(-Position)
+		.TransformBy(Rotation.Inverse())
+		.Scale(FVector2D(1.f) / Scale)
+		.ShiftBy(FVector2D(Heightmap->GetSizeX(), Heightmap->GetSizeY()) / 2.f);
+}
+
+FFloatInterval FVoxelLandmassHeightmapBrushImpl::GetHeightRange(const FVoxelBox2D& LocalBounds) const
+{
+	const FVoxelBox2D PixelBounds = GetPixelBounds(LocalBounds);
+	const FFloatInterval NormalizedRange = Heightmap->GetHeightRange(PixelBounds.Min, PixelBounds.Max);
+
+	const auto Transform = [](const FFloatInterval& Interval, const float InScale, const float Offset)
+	{
+		const float A = Interval.Min * InScale + Offset;
+		const float B = Interval.Max * InScale + Offset;
+		return FFloatInterval(FMath::Min(A, B), FMath::Max(A, B));
+	};
+
+	FFloatInterval Range = Transform(NormalizedRange, InnerScaleZ, InnerOffsetZ);
+	if (Brush.bSubtractive)
+	{
+		Range = Transform(Range, -1.f, 0.f);
+	}
+
+	// The heightmap can be tilted, find the range of the tilt offset over the bounds corners
+	{
+		FFloatInterval Rotation3DRange(MAX_flt, -MAX_flt);
+		for (const FVector2D& Corner : {
+			LocalBounds.Min,
+			FVector2D(LocalBounds.Max.X, LocalBounds.Min.Y),
+			FVector2D(LocalBounds.Min.X, LocalBounds.Max.Y),
+			LocalBounds.Max })
+		{
+			const float Rotation3DHeight = FVector2D::DotProduct(Corner - Position, Rotation3D);
+			Rotation3DRange.Min = FMath::Min(Rotation3DRange.Min, Rotation3DHeight);
+			Rotation3DRange.Max = FMath::Max(Rotation3DRange.Max, Rotation3DHeight);
+		}
+
+		Range.Min -= Rotation3DRange.Max;
+		Range.Max -= Rotation3DRange.Min;
+	}
+
+	return Transform(Range, ScaleZ, OffsetZ);
 }
 
 float FVoxelLandmassHeightmapBrushImpl::GetDistance(const FVector& LocalPosition) const
@@ -169,4 +218,27 @@ TVoxelFutureValue<FVoxelFloatBuffer> FVoxelHeightmapDistanceField::GetDistances(
 	{
 		Node.Brush = Brush;
 	};
+}
+
+TOptional<FFloatInterval> FVoxelHeightmapDistanceField::GetDistanceRange(const FVoxelBox& InBounds) const
+{
+	const FVoxelBox2D Bounds2D(FVector2d(InBounds.Min), FVector2d(InBounds.Max));
+	const FFloatInterval HeightRange = Brush->GetHeightRange(Bounds2D);
+
+	// Distance = max(Z - Height, Distance2D), Distance2D being negative inside the heightmap footprint
+	const FVoxelBox2D PixelBounds = Brush->GetPixelBounds(Bounds2D);
+	const FVector2D HalfSize = FVector2D(Brush->Heightmap->GetSizeX(), Brush->Heightmap->GetSizeY()) / 2.f;
+
+	const FVector2D MaxEdgeDistance = FVector2D(
+		FMath::Max(FMath::Abs(PixelBounds.Min.X - HalfSize.X), FMath::Abs(PixelBounds.Max.X - HalfSize.X)) - HalfSize.X,
+		FMath::Max(FMath::Abs(PixelBounds.Min.Y - HalfSize.Y), FMath::Abs(PixelBounds.Max.Y - HalfSize.Y)) - HalfSize.Y) * Brush->Scale;
+
+	// Don't bother bounding the outside distance
+	const float MaxDistance2D = MaxEdgeDistance.X <= 0.f && MaxEdgeDistance.Y <= 0.f
+		? FMath::Max(MaxEdgeDistance.X, MaxEdgeDistance.Y)
+		: MAX_flt;
+
+	return FFloatInterval(
+		InBounds.Min.Z - HeightRange.Max,
+		FMath::Max(InBounds.Max.Z - HeightRange.Min, MaxDistance2D));
 }
\ No newline at end of file
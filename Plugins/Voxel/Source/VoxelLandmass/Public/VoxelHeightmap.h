@@ -12,9 +12,12 @@ class VOXELLANDMASS_API FVoxelHeightmap
 public:
 	FVoxelHeightmap() = default;
 
+	// Size in pixels of the cells of the min/max pyramid
+	static constexpr int32 PyramidCellSize = 8;
+
 	int64 GetAllocatedSize() const
 	{
-		return Heights.GetAllocatedSize();
+		return Heights.GetAllocatedSize() + Pyramid.GetAllocatedSize();
 	}
 	void Serialize(FArchive& Ar);
 
@@ -55,6 +58,11 @@ public:
 		return Heights[Index] / float(MAX_uint16);
 	}
 
+	// Conservative range of the bilinearly interpolated heights in [Min, Max], in pixels
+	// Heights are normalized, same as GetHeight
+	FFloatInterval GetHeightRange(const FVector2D& Min, const FVector2D& Max) const;
+	FFloatInterval GetHeightRange() const;
+
 public:
 	void Initialize(
 		int32 NewSizeX,
@@ -62,11 +70,15 @@ public:
 		TVoxelArray<uint16>&& NewHeights);
 
 	TSharedRef<FVoxelRDGExternalBuffer> GetHeights_RenderThread() const;
+
+private:
+	void BuildPyramid();
 	
 private:
 	int32 SizeX = 0;
 	int32 SizeY = 0;
 	TVoxelArray<uint16> Heights;
+	FVoxelMinMaxPyramid Pyramid;
 
 	mutable TSharedPtr<FVoxelRDGExternalBuffer> Heights_RenderThread;
 };
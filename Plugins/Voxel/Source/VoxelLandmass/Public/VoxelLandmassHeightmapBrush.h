@@ -54,6 +54,11 @@ struct VOXELLANDMASS_API FVoxelLandmassHeightmapBrushImpl : TVoxelBrushImpl<FVox
 
 	float ScaleZ = 0;
 	float OffsetZ = 0;
+
+	// LocalBounds converted to heightmap pixels
+	FVoxelBox2D GetPixelBounds(const FVoxelBox2D& LocalBounds) const;
+	// Conservative range of the surface height over LocalBounds, in local space
+	FFloatInterval GetHeightRange(const FVoxelBox2D& LocalBounds) const;
 	
 	virtual float GetDistance(const FVector& LocalPosition) const override;
 	virtual TSharedPtr<FVoxelDistanceField> GetDistanceField() const override;
@@ -78,4 +83,5 @@ struct FVoxelHeightmapDistanceField : public FVoxelDistanceField
 	TSharedPtr<const FVoxelLandmassHeightmapBrushImpl> Brush;
 
 	virtual TVoxelFutureValue<FVoxelFloatBuffer> GetDistances(const FVoxelQuery& Query) const override;
+	virtual TOptional<FFloatInterval> GetDistanceRange(const FVoxelBox& Bounds) const override;
 };
\ No newline at end of file
@@ -38,4 +38,9 @@ struct FVoxelNode_SampleLandmassBrushes : public FVoxelNode
 	VOXEL_INPUT_PIN(bool, HermiteInterpolation, true);
 
 	VOXEL_OUTPUT_PIN(FVoxelFloatBuffer, Distance, DensityPin);
+
+	virtual bool OnlyDependsOnInputs() const override
+	{
+		return true;
+	}
 };
\ No newline at end of file
@@ -14,7 +14,7 @@ DEFINE_VOXEL_NODE_CPU(FVoxelNode_MakeMaterialLayerDetailTexture, DetailTexture)
 	return VOXEL_ON_COMPLETE(AsyncThread, DetailTextureQueryData, Layers, Name)
 	{
 		FindVoxelQueryData(FVoxelPositionQueryData, PositionQueryData);
-		CheckVoxelBuffersNum(Layers, PositionQueryData->GetPositions());
+		CheckVoxelBuffersNum(Layers, *PositionQueryData);
 
 		const uint8 Class = Layers[0].Class;
 
@@ -69,7 +69,7 @@ DEFINE_VOXEL_NODE_GPU(FVoxelNode_MakeMaterialLayerDetailTexture, DetailTexture)
 		VOXEL_USE_NAMESPACE(MetaGraph);
 
 		FindVoxelQueryData(FVoxelPositionQueryData, PositionQueryData);
-		CheckVoxelBuffersNum(Layers, PositionQueryData->GetPositions());
+		CheckVoxelBuffersNum(Layers, *PositionQueryData);
 
 		const FRDGTextureRef Texture = GraphBuilder.CreateTexture(
 			FRDGTextureDesc::Create2D(
@@ -3,15 +3,68 @@
 #include "Nodes/MarchingCube/VoxelMarchingCubeMesh_LocalVF.h"
 #include "Nodes/VoxelMeshMaterialNodes.h"
 
+DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelMarchingCubeCompactVerticesSavings);
+
+void FVoxelMarchingCubeCompactPositionVertexBuffer::Init(const int32 InNumVertices)
+{
+	NumVertices = InNumVertices;
+	FVoxelUtilities::SetNumFast(Positions, NumVertices);
+}
+
+void FVoxelMarchingCubeCompactPositionVertexBuffer::BindPositionVertexBuffer(const FVertexFactory* VertexFactory, FLocalVertexFactory::FDataType& Data) const
+{
+	// No SRV: manual vertex fetch reads positions as floats
+	Data.PositionComponent = FVertexStreamComponent(
+		this,
+		0,
+		GetStride(),
+		VET_Short4N);
+}
+
+void FVoxelMarchingCubeCompactPositionVertexBuffer::InitRHI()
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInRenderingThread());
+	ensure(Positions.Num() == NumVertices);
+
+	if (NumVertices == 0)
+	{
+		return;
+	}
+
+	FRHIResourceCreateInfo CreateInfo(TEXT("VoxelMarchingCubeCompactPositions"));
+	VertexBufferRHI = RHICreateVertexBuffer(NumVertices * GetStride(), BUF_Static, CreateInfo);
+
+	FVoxelRenderUtilities::UpdateBuffer(VertexBufferRHI, Positions);
+
+	// Free up memory
+	Positions.Empty();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+FVoxelMarchingCubeMesh_LocalVF::~FVoxelMarchingCubeMesh_LocalVF()
+{
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelMarchingCubeCompactVerticesSavings, CompactBytesSaved);
+}
+
 int64 FVoxelMarchingCubeMesh_LocalVF::GetAllocatedSize() const
 {
 	return
 		IndexBuffer.GetAllocatedSize() +
 		PositionVertexBuffer.GetNumVertices() * PositionVertexBuffer.GetStride() +
+		CompactPositionVertexBuffer.GetNumVertices() * CompactPositionVertexBuffer.GetStride() +
 		StaticMeshVertexBuffer.GetResourceSize() +
 		ColorVertexBuffer.GetNumVertices() * ColorVertexBuffer.GetStride();
 }
 
+FVector FVoxelMarchingCubeMesh_LocalVF::GetScale() const
+{
+	return bCompactVertices ? FVector(PositionScale) : FVector::OneVector;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -36,18 +89,33 @@ void FVoxelMarchingCubeMesh_LocalVF::Initialize_RenderThread(ERHIFeatureLevel::T
 	check(IsInRenderingThread());
 
 	ensure(IndexBuffer.GetNumIndices() > 0);
-	ensure(PositionVertexBuffer.GetNumVertices() > 0);
+	ensure(GetNumVertices() > 0);
 
 	VOXEL_INLINE_COUNTER("Index"     , IndexBuffer           .InitResource());
-	VOXEL_INLINE_COUNTER("Position"  , PositionVertexBuffer  .InitResource());
 	VOXEL_INLINE_COUNTER("StaticMesh", StaticMeshVertexBuffer.InitResource());
 	VOXEL_INLINE_COUNTER("Color"     , ColorVertexBuffer     .InitResource());
+
+	if (bCompactVertices)
+	{
+		VOXEL_INLINE_COUNTER("CompactPosition", CompactPositionVertexBuffer.InitResource());
+	}
+	else
+	{
+		VOXEL_INLINE_COUNTER("Position", PositionVertexBuffer.InitResource());
+	}
 	
 	check(!VertexFactory);
 	VertexFactory = MakeShared<FLocalVertexFactory>(FeatureLevel, "FVoxelDefaultMeshRenderData");
 
 	FLocalVertexFactory::FDataType Data;
-	PositionVertexBuffer.BindPositionVertexBuffer(VertexFactory.Get(), Data);
+	if (bCompactVertices)
+	{
+		CompactPositionVertexBuffer.BindPositionVertexBuffer(VertexFactory.Get(), Data);
+	}
+	else
+	{
+		PositionVertexBuffer.BindPositionVertexBuffer(VertexFactory.Get(), Data);
+	}
 	StaticMeshVertexBuffer.BindTangentVertexBuffer(VertexFactory.Get(), Data);
 	StaticMeshVertexBuffer.BindPackedTexCoordVertexBuffer(VertexFactory.Get(), Data);
 	ColorVertexBuffer.BindColorVertexBuffer(VertexFactory.Get(), Data);
@@ -56,7 +124,9 @@ void FVoxelMarchingCubeMesh_LocalVF::Initialize_RenderThread(ERHIFeatureLevel::T
 	VOXEL_INLINE_COUNTER("VertexFactory", VertexFactory->InitResource());
 
 #if RHI_RAYTRACING
-	if (IsRayTracingEnabled())
+	// Raytracing geometry requires float positions
+	if (IsRayTracingEnabled() &&
+		!bCompactVertices)
 	{
 		VOXEL_SCOPE_COUNTER("Raytracing");
 		
@@ -90,6 +160,7 @@ void FVoxelMarchingCubeMesh_LocalVF::Destroy_RenderThread()
 
 	IndexBuffer.ReleaseResource();
 	PositionVertexBuffer.ReleaseResource();
+	CompactPositionVertexBuffer.ReleaseResource();
 	StaticMeshVertexBuffer.ReleaseResource();
 	ColorVertexBuffer.ReleaseResource();
 
@@ -98,9 +169,8 @@ void FVoxelMarchingCubeMesh_LocalVF::Destroy_RenderThread()
 	VertexFactory.Reset();
 	
 #if RHI_RAYTRACING
-	if (IsRayTracingEnabled())
+	if (RayTracingGeometry)
 	{
-		check(RayTracingGeometry);
 		RayTracingGeometry->ReleaseResource();
 		RayTracingGeometry.Reset();
 	}
@@ -123,7 +193,7 @@ bool FVoxelMarchingCubeMesh_LocalVF::Draw_RenderThread(
 	BatchElement.FirstIndex = 0;
 	BatchElement.NumPrimitives = IndexBuffer.GetNumIndices() / 3;
 	BatchElement.MinVertexIndex = 0;
-	BatchElement.MaxVertexIndex = PositionVertexBuffer.GetNumVertices() - 1;
+	BatchElement.MaxVertexIndex = GetNumVertices() - 1;
 	
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 	MeshBatch.VisualizeLODIndex = LOD % GEngine->LODColorationColors.Num();
@@ -136,4 +206,11 @@ const FRayTracingGeometry* FVoxelMarchingCubeMesh_LocalVF::DrawRaytracing_Render
 {
 	MeshBatch.VertexFactory = VertexFactory.Get();
 	return RayTracingGeometry.Get();
-}
\ No newline at end of file
+}
+
+int32 FVoxelMarchingCubeMesh_LocalVF::GetNumVertices() const
+{
+	return bCompactVertices
+		? CompactPositionVertexBuffer.GetNumVertices()
+		: PositionVertexBuffer.GetNumVertices();
+}
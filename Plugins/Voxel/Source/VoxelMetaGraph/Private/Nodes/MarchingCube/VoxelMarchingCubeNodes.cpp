@@ -3,9 +3,12 @@
 #include "Nodes/MarchingCube/VoxelMarchingCubeNodes.h"
 #include "Nodes/MarchingCube/VoxelMarchingCubeProcessor.h"
 #include "Nodes/MarchingCube/VoxelMarchingCubeMesh_LocalVF.h"
+#include "Nodes/VoxelCacheNode.h"
+#include "Nodes/VoxelExecCodeGenNode.h"
 #include "Nodes/VoxelPositionNodes.h"
 #include "VoxelMetaGraphRuntimeUtilities.h"
 #include "VoxelCollision/VoxelCollisionCooker.h"
+#include "VoxelCollision/VoxelCollisionProcessor.h"
 #include "VoxelCollision/VoxelTriangleMeshCollider.h"
 #include "Transvoxel.h"
 
@@ -56,7 +59,17 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_GenerateSurface, Surface)
 	const TValue<bool> EnableDistanceChecks = Get(EnableDistanceChecksPin, Query);
 	const TValue<float> DistanceChecksTolerance = Get(DistanceChecksTolerancePin, Query);
 
-	return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, LODQueryData, VoxelSize, EnableDistanceChecks, DistanceChecksTolerance)
+	// Only codegen graphs can prove a uniform sign, anything else would evaluate the probe for nothing
+	const bool bCanCheckRange = INLINE_LAMBDA
+	{
+		const TSharedPtr<const FVoxelNodeRuntime::FPinData> OutputPinData = GetNodeRuntime().GetPinData(DensityPin).OutputPinData;
+		return
+			OutputPinData &&
+			OutputPinData->ComputeState &&
+			OutputPinData->ComputeState->Node->IsA<FVoxelNode_ExecCodeGen>();
+	};
+
+	return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, LODQueryData, VoxelSize, EnableDistanceChecks, DistanceChecksTolerance, bCanCheckRange)
 	{
 		const FVoxelBox Bounds = BoundsQueryData->Bounds;
 		const int32 LOD = LODQueryData->LOD;
@@ -110,6 +123,24 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_GenerateSurface, Surface)
 				return false;
 			}
 
+			// Probe whose position bounds cover all the densities of the chunk
+			// Codegen graphs will return a constant if they can prove the densities all have the same sign
+			TValue<bool> HasUniformSign = false;
+			if (bCanCheckRange)
+			{
+				FVoxelQuery RangeQuery = Query.MakeCpuQuery();
+				RangeQuery.Add<FVoxelGradientStepQueryData>().Step = ScaledVoxelSize;
+				RangeQuery.Add<FVoxelDensePositionQueryData>().Initialize(FVector3f(Bounds.Min), DataSize * ScaledVoxelSize / 2.f, FIntVector(2));
+				RangeQuery.Add<FVoxelUniformSignQueryData>().CallstackNum = Query.Callstack.Num();
+
+				const TValue<TVoxelBuffer<float>> RangeDensities = Get(DensityPin, RangeQuery);
+
+				HasUniformSign = VOXEL_ON_COMPLETE_CUSTOM(bool, "RangeChecks", AnyThread, RangeDensities)
+				{
+					return RangeDensities.IsConstant();
+				};
+			}
+
 			const float Size = Bounds.Size().GetMax();
 			const float Tolerance = FMath::Max(DistanceChecksTolerance, 0.f);
 
@@ -119,8 +150,13 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_GenerateSurface, Surface)
 
 			const TValue<TBufferView<float>> Densities = GetBufferView(DensityPin, DensityQuery);
 
-			return VOXEL_ON_COMPLETE_CUSTOM(bool, "DistanceChecks", AsyncThread, Densities, Size, Tolerance)
+			return VOXEL_ON_COMPLETE_CUSTOM(bool, "DistanceChecks", AsyncThread, HasUniformSign, Densities, Size, Tolerance)
 			{
+				if (HasUniformSign)
+				{
+					return true;
+				}
+
 				bool bCanSkip = true;
 				for (const float Density : Densities)
 				{
@@ -357,9 +393,11 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateCollider, Collider)
 {
 	FindVoxelQueryData(FVoxelBoundsQueryData, BoundsQueryData);
 
-	const TValue<FVoxelMarchingCubeSurface> Surface = Get(SurfacePin, Query);
+	// Share the surface with the other chunks of the same bounds & LOD
+	const TValue<FVoxelMarchingCubeSurface> Surface = TValue<FVoxelMarchingCubeSurface>(GetSubsystem<FVoxelSharedPinValueSubsystem>().Get(GetNodeRuntime(), SurfacePin, Query));
+	const TSharedRef<FVoxelCollisionCookPriority> CookPriority = GetNodeRuntime().GetSubsystem<FVoxelCollisionProcessor>().CookPriority;
 
-	return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, Surface)
+	return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, CookPriority, Surface)
 	{
 		if (Surface->Vertices.Num() == 0)
 		{
@@ -369,7 +407,7 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateCollider, Collider)
 		const TValue<TBufferView<int32>> Indices = Surface->Indices.MakeView();
 		const TValue<TBufferView<FVector>> Vertices = Surface->Vertices.MakeView();
 
-		return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, Surface, Indices, Vertices)
+		return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, CookPriority, Surface, Indices, Vertices)
 		{
 			check(Surface->Indices.Num() % 3 == 0);
 			const int32 NumTriangles = Surface->Indices.Num() / 3;
@@ -404,7 +442,7 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateCollider, Collider)
 				Materials = GetBufferView(PhysicalMaterialPin, MaterialQuery);
 			}
 
-			return VOXEL_ON_COMPLETE(AsyncThread, Surface, Indices, Vertices, Materials)
+			return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, CookPriority, Surface, Indices, Vertices, Materials)
 			{
 				TVoxelArray<FVector3f> Positions;
 				FVoxelUtilities::SetNumFast(Positions, Vertices.Num());
@@ -414,36 +452,49 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateCollider, Collider)
 					Positions[Index] = Vertices[Index] * Surface->ScaledVoxelSize;
 				}
 
+				TVoxelArray<uint16> MaterialIndices;
+				TArray<TWeakObjectPtr<UPhysicalMaterial>> PhysicalMaterials;
+
 				if (Materials.IsConstant())
 				{
-					const TSharedPtr<FVoxelTriangleMeshCollider> Collider = FVoxelCollisionCooker::CookTriangleMesh(Indices.GetRawView(), Positions, {});
-					if (Collider)
-					{
-						Collider->PhysicalMaterials.Add(Materials.GetConstant().Material);
-					}
-					return Collider;
+					PhysicalMaterials.Add(Materials.GetConstant().Material);
 				}
-
-				TVoxelArray<uint16> MaterialIndices;
-				TMap<uint64, uint16> MaterialToIndex;
-				TVoxelArray<TWeakObjectPtr<UPhysicalMaterial>> PhysicalMaterials;
-
-				for (const FVoxelPhysicalMaterial& Material : Materials)
+				else
 				{
-					uint16& Index = MaterialToIndex.FindOrAdd(ReinterpretCastRef<uint64>(Material), MAX_uint16);
-					if (Index == MAX_uint16)
+					TMap<uint64, uint16> MaterialToIndex;
+					for (const FVoxelPhysicalMaterial& Material : Materials)
 					{
-						Index = PhysicalMaterials.Add(Material.Material);
+						uint16& Index = MaterialToIndex.FindOrAdd(ReinterpretCastRef<uint64>(Material), MAX_uint16);
+						if (Index == MAX_uint16)
+						{
+							Index = PhysicalMaterials.Add(Material.Material);
+						}
+						MaterialIndices.Add(Index);
 					}
-					MaterialIndices.Add(Index);
 				}
 
-				const TSharedPtr<FVoxelTriangleMeshCollider> Collider = FVoxelCollisionCooker::CookTriangleMesh(Indices.GetRawView(), Positions, MaterialIndices);
-				if (Collider)
-				{
-					Collider->PhysicalMaterials = MoveTemp(PhysicalMaterials);
-				}
-				return Collider;
+				const TSharedRef<FVoxelFuturePinValueState> State = MakeShared<FVoxelFuturePinValueState>(FVoxelPinType::Make<FVoxelCollider>());
+
+				FVoxelCollisionCooker::CookMeshAsync(
+					BoundsQueryData->Bounds,
+					CookPriority,
+					TVoxelArray<int32>(Indices.GetRawView()),
+					MoveTemp(Positions),
+					MoveTemp(MaterialIndices),
+					MoveTemp(PhysicalMaterials),
+					Surface->ScaledVoxelSize,
+					[State](const TSharedPtr<FVoxelCollider>& Collider)
+					{
+						if (!Collider)
+						{
+							State->SetValue(FVoxelSharedPinValue::Make<FVoxelCollider>());
+							return;
+						}
+
+						State->SetValue(FVoxelSharedPinValue::Make(Collider.ToSharedRef()));
+					});
+
+				return TValue<FVoxelCollider>(FVoxelFutureValue(State));
 			};
 		};
 	};
@@ -451,7 +502,8 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateCollider, Collider)
 
 DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateNavmesh, Navmesh)
 {
-	const TValue<FVoxelMarchingCubeSurface> Surface = Get(SurfacePin, Query);
+	// Share the surface with the other chunks of the same bounds & LOD
+	const TValue<FVoxelMarchingCubeSurface> Surface = TValue<FVoxelMarchingCubeSurface>(GetSubsystem<FVoxelSharedPinValueSubsystem>().Get(GetNodeRuntime(), SurfacePin, Query));
 
 	return VOXEL_ON_COMPLETE(AsyncThread, Surface)
 	{
@@ -495,9 +547,12 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateMesh, Mesh)
 	FindVoxelQueryData(FVoxelBoundsQueryData, BoundsQueryData);
 	FindVoxelQueryData(FVoxelLODQueryData, LODQueryData);
 	
-	const TValue<FVoxelMarchingCubeSurface> Surface = Get(SurfacePin, Query);
+	// Share the surface with the other chunks of the same bounds & LOD
+	const TValue<FVoxelMarchingCubeSurface> Surface = TValue<FVoxelMarchingCubeSurface>(GetSubsystem<FVoxelSharedPinValueSubsystem>().Get(GetNodeRuntime(), SurfacePin, Query));
+	const TValue<bool> CompactVertices = Get(CompactVerticesPin, Query);
+	const TValue<bool> OptimizeMesh = Get(OptimizeMeshPin, Query);
 
-	return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, LODQueryData, Surface)
+	return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, LODQueryData, Surface, CompactVertices, OptimizeMesh)
 	{
 		if (Surface->Vertices.Num() == 0)
 		{
@@ -507,7 +562,7 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateMesh, Mesh)
 		const TValue<TBufferView<int32>> Indices = Surface->Indices.MakeView();
 		const TValue<TBufferView<FVector>> Vertices = Surface->Vertices.MakeView();
 
-		return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, LODQueryData, Surface, Indices, Vertices)
+		return VOXEL_ON_COMPLETE(AsyncThread, BoundsQueryData, LODQueryData, Surface, CompactVertices, OptimizeMesh, Indices, Vertices)
 		{
 			FVoxelVectorBuffer QueryPositions;
 			{
@@ -543,30 +598,80 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateMesh, Mesh)
 
 			const TValue<FVoxelMeshMaterial> Material = Get(MaterialPin, MaterialQuery);
 
-			return VOXEL_ON_COMPLETE(AsyncThread, LODQueryData, Surface, Indices, Vertices, VertexData, Material)
+			return VOXEL_ON_COMPLETE(AsyncThread, LODQueryData, Surface, CompactVertices, OptimizeMesh, Indices, Vertices, VertexData, Material)
 			{
+				TVoxelArray<uint32> MeshIndices(Indices.GetRawView());
+
+				// Only set if OptimizeMesh
+				TVoxelArray<int32> NewToOldVertex;
+				if (OptimizeMesh)
+				{
+					TVoxelArray<FVector3f> Positions;
+					FVoxelUtilities::SetNumFast(Positions, Vertices.Num());
+					for (int32 Index = 0; Index < Vertices.Num(); Index++)
+					{
+						Positions[Index] = FVector3f(Vertices[Index]);
+					}
+
+					FVoxelMarchingCubeProcessor::OptimizeMesh(MeshIndices, Positions, NewToOldVertex);
+				}
+
+				const int32 NumVertices = OptimizeMesh ? NewToOldVertex.Num() : Vertices.Num();
+				const auto GetSourceVertex = [&](const int32 Index)
+				{
+					return OptimizeMesh ? NewToOldVertex[Index] : Index;
+				};
+
 				const TSharedRef<FVoxelMarchingCubeMesh_LocalVF> Mesh = MakeVoxelMesh<FVoxelMarchingCubeMesh_LocalVF>();
 				Mesh->LOD = LODQueryData->LOD;
 				Mesh->Bounds = FBox(ForceInit);
 				Mesh->MeshMaterial = Material;
+				Mesh->bCompactVertices = CompactVertices;
 
 				{
 					VOXEL_SCOPE_COUNTER("Indices");
 
 					Mesh->IndexBuffer.SetIndices(
-						TArray<uint32>(Indices.GetRawView()),
-						Vertices.Num() > MAX_uint16
+						TArray<uint32>(MeshIndices),
+						NumVertices > MAX_uint16
 						? EIndexBufferStride::Force32Bit
 						: EIndexBufferStride::Force16Bit);
 				}
 
+				if (Mesh->bCompactVertices)
+				{
+					VOXEL_SCOPE_COUNTER("Compact Positions");
+
+					// Quantize against the fixed chunk size, with a whole number of steps per voxel,
+					// so that neighboring chunks quantize their shared border vertices the same way
+					// Keep one voxel of margin for vertices slightly outside the chunk
+					const float Quantization = FMath::Max(1, MAX_int16 / (Surface->ChunkSize + 1));
+
+					// Positions are stored in [-1, 1], the mesh component scale brings them back to chunk-local space
+					Mesh->PositionScale = MAX_int16 / Quantization * Surface->ScaledVoxelSize;
+
+					Mesh->CompactPositionVertexBuffer.Init(NumVertices);
+					for (int32 Index = 0; Index < NumVertices; Index++)
+					{
+						const FVector3f Vertex = FVector3f(Vertices[GetSourceVertex(Index)]);
+
+						FVoxelMarchingCubeCompactPositionVertexBuffer::FPosition& Position = Mesh->CompactPositionVertexBuffer.Positions[Index];
+						Position.X = FMath::Clamp<int32>(FMath::RoundToInt(Vertex.X * Quantization), -MAX_int16, MAX_int16);
+						Position.Y = FMath::Clamp<int32>(FMath::RoundToInt(Vertex.Y * Quantization), -MAX_int16, MAX_int16);
+						Position.Z = FMath::Clamp<int32>(FMath::RoundToInt(Vertex.Z * Quantization), -MAX_int16, MAX_int16);
+						Position.W = MAX_int16;
+
+						Mesh->Bounds += FVector(Position.X, Position.Y, Position.Z) / MAX_int16;
+					}
+				}
+				else
 				{
 					VOXEL_SCOPE_COUNTER("Positions");
 
-					Mesh->PositionVertexBuffer.Init(Vertices.Num(), false);
-					for (int32 Index = 0; Index < Vertices.Num(); Index++)
+					Mesh->PositionVertexBuffer.Init(NumVertices, false);
+					for (int32 Index = 0; Index < NumVertices; Index++)
 					{
-						const FVector3f Position = FVector3f(Vertices[Index]) * Surface->ScaledVoxelSize;
+						const FVector3f Position = FVector3f(Vertices[GetSourceVertex(Index)]) * Surface->ScaledVoxelSize;
 						Mesh->Bounds += FVector(Position);
 						Mesh->PositionVertexBuffer.VertexPosition(Index) = Position;
 					}
@@ -574,17 +679,24 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateMesh, Mesh)
 
 				const int32 NumTextureCoordinates = FMath::Max(1, VertexData->AllTextureCoordinates.Num());
 
-				Mesh->StaticMeshVertexBuffer.SetUseFullPrecisionUVs(true);
-				Mesh->StaticMeshVertexBuffer.Init(Vertices.Num(), NumTextureCoordinates, false);
+				Mesh->StaticMeshVertexBuffer.SetUseFullPrecisionUVs(!Mesh->bCompactVertices);
+				Mesh->StaticMeshVertexBuffer.Init(NumVertices, NumTextureCoordinates, false);
+
+				if (Mesh->bCompactVertices)
+				{
+					// 12 -> 8 bytes per position, 8 -> 4 bytes per UV
+					Mesh->CompactBytesSaved = int64(NumVertices) * (4 + 4 * NumTextureCoordinates);
+					INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelMarchingCubeCompactVerticesSavings, Mesh->CompactBytesSaved);
+				}
 
 				{
 					VOXEL_SCOPE_COUNTER("Tangents");
 
 					if (VertexData->Normals.Num() == Vertices.Num())
 					{
-						for (int32 Index = 0; Index < Vertices.Num(); Index++)
+						for (int32 Index = 0; Index < NumVertices; Index++)
 						{
-							const FVector3f Normal = VertexData->Normals[Index].GetSafeNormal();
+							const FVector3f Normal = VertexData->Normals[GetSourceVertex(Index)].GetSafeNormal();
 
 							Mesh->StaticMeshVertexBuffer.SetVertexTangents(
 								Index,
@@ -595,7 +707,7 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateMesh, Mesh)
 					}
 					else
 					{
-						for (int32 Index = 0; Index < Vertices.Num(); Index++)
+						for (int32 Index = 0; Index < NumVertices; Index++)
 						{
 							Mesh->StaticMeshVertexBuffer.SetVertexTangents(
 								Index,
@@ -615,14 +727,14 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateMesh, Mesh)
 							VertexData->AllTextureCoordinates[TexCoord].Num() == Vertices.Num())
 						{
 							const TVoxelArray<FVector2f>& TextureCoordinates = VertexData->AllTextureCoordinates[TexCoord];
-							for (int32 Index = 0; Index < Vertices.Num(); Index++)
+							for (int32 Index = 0; Index < NumVertices; Index++)
 							{
-								Mesh->StaticMeshVertexBuffer.SetVertexUV(Index, TexCoord, TextureCoordinates[Index]);
+								Mesh->StaticMeshVertexBuffer.SetVertexUV(Index, TexCoord, TextureCoordinates[GetSourceVertex(Index)]);
 							}
 						}
 						else
 						{
-							for (int32 Index = 0; Index < Vertices.Num(); Index++)
+							for (int32 Index = 0; Index < NumVertices; Index++)
 							{
 								Mesh->StaticMeshVertexBuffer.SetVertexUV(Index, TexCoord, FVector2f(ForceInit));
 							}
@@ -633,18 +745,18 @@ DEFINE_VOXEL_NODE(FVoxelNode_FVoxelMarchingCubeSurface_CreateMesh, Mesh)
 				{
 					VOXEL_SCOPE_COUNTER("Colors");
 
-					Mesh->ColorVertexBuffer.Init(Vertices.Num(), false);
+					Mesh->ColorVertexBuffer.Init(NumVertices, false);
 
 					if (VertexData->Colors.Num() == Vertices.Num())
 					{
-						for (int32 Index = 0; Index < Vertices.Num(); Index++)
+						for (int32 Index = 0; Index < NumVertices; Index++)
 						{
-							Mesh->ColorVertexBuffer.VertexColor(Index) = VertexData->Colors[Index];
+							Mesh->ColorVertexBuffer.VertexColor(Index) = VertexData->Colors[GetSourceVertex(Index)];
 						}
 					}
 					else
 					{
-						for (int32 Index = 0; Index < Vertices.Num(); Index++)
+						for (int32 Index = 0; Index < NumVertices; Index++)
 						{
 							Mesh->ColorVertexBuffer.VertexColor(Index) = FColor(ForceInit);
 						}
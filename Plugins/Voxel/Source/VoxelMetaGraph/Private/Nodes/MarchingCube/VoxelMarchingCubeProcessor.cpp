@@ -2,6 +2,7 @@
 
 #include "Nodes/MarchingCube/VoxelMarchingCubeProcessor.h"
 #include "Transvoxel.h"
+#include "MeshOptimizer.h"
 
 void FVoxelMarchingCubeProcessor::MainPass(
 	const TConstVoxelArrayView<float> Densities,
@@ -196,4 +197,60 @@ Full:
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+void FVoxelMarchingCubeProcessor::OptimizeMesh(
+	TVoxelArray<uint32>& Indices,
+	const TConstVoxelArrayView<FVector3f> Positions,
+	TVoxelArray<int32>& OutNewToOldVertex)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(Indices.Num() % 3 == 0);
+
+	const int32 NumVertices = Positions.Num();
+	constexpr int32 CacheSize = 16;
+
+	const float ACMRBefore = meshopt_analyzeVertexCache(Indices.GetData(), Indices.Num(), NumVertices, CacheSize, 0, 0).acmr;
+
+	{
+		VOXEL_SCOPE_COUNTER("optimizeVertexCache");
+		meshopt_optimizeVertexCache(Indices.GetData(), Indices.GetData(), Indices.Num(), NumVertices);
+	}
+	{
+		VOXEL_SCOPE_COUNTER("optimizeOverdraw");
+		// Allow ACMR to get 5% worse for better overdraw
+		meshopt_optimizeOverdraw(
+			Indices.GetData(),
+			Indices.GetData(),
+			Indices.Num(),
+			&Positions[0].X,
+			NumVertices,
+			sizeof(FVector3f),
+			1.05f);
+	}
+
+	TVoxelArray<uint32> OldToNewVertex;
+	FVoxelUtilities::SetNumFast(OldToNewVertex, NumVertices);
+
+	int32 NumNewVertices;
+	{
+		VOXEL_SCOPE_COUNTER("optimizeVertexFetchRemap");
+		NumNewVertices = meshopt_optimizeVertexFetchRemap(OldToNewVertex.GetData(), Indices.GetData(), Indices.Num(), NumVertices);
+		meshopt_remapIndexBuffer(Indices.GetData(), Indices.GetData(), Indices.Num(), OldToNewVertex.GetData());
+	}
+
+	// Unreferenced vertices are dropped
+	FVoxelUtilities::SetNumFast(OutNewToOldVertex, NumNewVertices);
+	for (int32 OldIndex = 0; OldIndex < NumVertices; OldIndex++)
+	{
+		const uint32 NewIndex = OldToNewVertex[OldIndex];
+		if (NewIndex != ~0u)
+		{
+			OutNewToOldVertex[NewIndex] = OldIndex;
+		}
+	}
+
+	const float ACMRAfter = meshopt_analyzeVertexCache(Indices.GetData(), Indices.Num(), NumNewVertices, CacheSize, 0, 0).acmr;
+
+	LOG_VOXEL(Verbose, "Marching cube mesh optimized: %d triangles, ACMR %.3f -> %.3f", Indices.Num() / 3, ACMRBefore, ACMRAfter);
+}
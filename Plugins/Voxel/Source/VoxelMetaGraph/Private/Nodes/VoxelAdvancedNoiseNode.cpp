@@ -44,6 +44,83 @@ BEGIN_VOXEL_COMPUTE_SHADER(VoxelNode_AdvancedNoise2D)
 	VOXEL_SHADER_PARAMETER_UAV(Buffer<float>, Result)
 END_VOXEL_SHADER()
 
+ispc::EOctaveType GetISPCOctaveType(const EVoxelAdvancedNoiseOctaveType Type)
+{
+	switch (Type)
+	{
+	default: ensure(false);
+
+#define CASE(Name) case EVoxelAdvancedNoiseOctaveType::Name: return ispc::OctaveType_ ## Name;
+
+	CASE(SmoothPerlin);
+	CASE(BillowyPerlin);
+	CASE(RidgedPerlin);
+
+	CASE(SmoothCellular);
+	CASE(BillowyCellular);
+	CASE(RidgedCellular);
+
+#undef CASE
+	}
+}
+
+// Returns false if a strength buffer has the wrong size
+template<typename OctaveTypesType, typename OctaveStrengthsType>
+bool BuildOctaves(
+	const int32 NumOctaves,
+	const uint8 DefaultOctaveType,
+	const OctaveTypesType& OctaveTypes,
+	const OctaveStrengthsType& OctaveStrengths,
+	const int32 Num,
+	TArray<ispc::FOctave>& OutOctaves)
+{
+	const int32 SafeNumOctaves = FMath::Clamp(NumOctaves, 1, 255);
+	OutOctaves.Reserve(SafeNumOctaves);
+
+	for (int32 Index = 0; Index < SafeNumOctaves; Index++)
+	{
+		ispc::FOctave& Octave = OutOctaves.Emplace_GetRef(ispc::FOctave{});
+
+		if (OctaveTypes.IsValidIndex(Index))
+		{
+			Octave.Type = GetISPCOctaveType(EVoxelAdvancedNoiseOctaveType(OctaveTypes[Index]));
+		}
+		else
+		{
+			Octave.Type = GetISPCOctaveType(EVoxelAdvancedNoiseOctaveType(DefaultOctaveType));
+		}
+
+		if (OctaveStrengths.IsValidIndex(Index))
+		{
+			const TBufferView<float>& Strength = OctaveStrengths[Index];
+
+			if (Strength.IsConstant())
+			{
+				Octave.bStrengthIsConstant = true;
+				Octave.StrengthConstant = Strength.GetConstant();
+			}
+			else
+			{
+				if (Strength.Num() != Num)
+				{
+					return false;
+				}
+
+				Octave.bStrengthIsConstant = false;
+				Octave.StrengthArray = Strength.GetData();
+			}
+		}
+		else
+		{
+			Octave.bStrengthIsConstant = true;
+			Octave.StrengthConstant = 1.f;
+			Octave.StrengthArray = nullptr;
+		}
+	}
+
+	return true;
+}
+
 END_VOXEL_NAMESPACE(MetaGraph)
 
 DEFINE_VOXEL_NODE_GPU(FVoxelNode_AdvancedNoise2D, Value)
@@ -131,26 +208,6 @@ DEFINE_VOXEL_NODE_GPU(FVoxelNode_AdvancedNoise2D, Value)
 	
 DEFINE_VOXEL_NODE_CPU(FVoxelNode_AdvancedNoise2D, Value)
 {
-	const auto GetISPCNoise = [](EVoxelAdvancedNoiseOctaveType Noise)
-	{
-		switch (Noise)
-		{
-		default: ensure(false);
-
-#define CASE(Name) case EVoxelAdvancedNoiseOctaveType::Name: return ispc::OctaveType_ ## Name;
-
-		CASE(SmoothPerlin);
-		CASE(BillowyPerlin);
-		CASE(RidgedPerlin);
-
-		CASE(SmoothCellular);
-		CASE(BillowyCellular);
-		CASE(RidgedCellular);
-
-#undef CASE
-		}
-	};
-
 	const TValue<TBufferView<FVector2D>> Positions = GetBufferView(PositionPin, Query);
 	const TValue<TBufferView<float>> Amplitudes = GetBufferView(AmplitudePin, Query);
 	const TValue<TBufferView<float>> FeatureScales = GetBufferView(FeatureScalePin, Query);
@@ -163,54 +220,17 @@ DEFINE_VOXEL_NODE_CPU(FVoxelNode_AdvancedNoise2D, Value)
 	const TArray<TValue<uint8>> OctaveTypes = Get(OctaveTypePins, Query);
 	const TArray<TValue<TBufferView<float>>> OctaveStrengths = GetBufferView(OctaveStrengthPins, Query);
 
-	return VOXEL_ON_COMPLETE(AsyncThread, Positions, Amplitudes, FeatureScales, Lacunarities, Gains, CellularJitters, NumOctaves, Seed, DefaultOctaveType, OctaveTypes, OctaveStrengths, GetISPCNoise)
+	return VOXEL_ON_COMPLETE(AsyncThread, Positions, Amplitudes, FeatureScales, Lacunarities, Gains, CellularJitters, NumOctaves, Seed, DefaultOctaveType, OctaveTypes, OctaveStrengths)
 	{
+		VOXEL_USE_NAMESPACE(MetaGraph);
+
 		const int32 Num = ComputeVoxelBuffersNum(Positions, Amplitudes, FeatureScales, Lacunarities, Gains, CellularJitters);
-		const int32 SafeNumOctaves = FMath::Clamp(NumOctaves, 1, 255);
 
 		TArray<ispc::FOctave> Octaves;
-		Octaves.Reserve(SafeNumOctaves);
-
-		for (int32 Index = 0; Index < SafeNumOctaves; Index++)
+		if (!BuildOctaves(NumOctaves, DefaultOctaveType, OctaveTypes, OctaveStrengths, Num, Octaves))
 		{
-			ispc::FOctave& Octave = Octaves.Emplace_GetRef(ispc::FOctave{});
-
-			if (OctaveTypes.IsValidIndex(Index))
-			{
-				Octave.Type = GetISPCNoise(EVoxelAdvancedNoiseOctaveType(OctaveTypes[Index]));
-			}
-			else
-			{
-				Octave.Type = GetISPCNoise(EVoxelAdvancedNoiseOctaveType(DefaultOctaveType));
-			}
-
-			if (OctaveStrengths.IsValidIndex(Index))
-			{
-				const TBufferView<float>& Strength = OctaveStrengths[Index];
-
-				if (Strength.IsConstant())
-				{
-					Octave.bStrengthIsConstant = true;
-					Octave.StrengthConstant = Strength.GetConstant();
-				}
-				else
-				{
-					if (Strength.Num() != Num)
-					{
-						RaiseBufferError();
-						return {};
-					}
-
-					Octave.bStrengthIsConstant = false;
-					Octave.StrengthArray = Strength.GetData();
-				}
-			}
-			else
-			{
-				Octave.bStrengthIsConstant = true;
-				Octave.StrengthConstant = 1.f;
-				Octave.StrengthArray = nullptr;
-			}
+			RaiseBufferError();
+			return {};
 		}
 
 		TVoxelArray<float> ReturnValue = FVoxelFloatBuffer::Allocate(Num);
@@ -238,4 +258,174 @@ DEFINE_VOXEL_NODE_CPU(FVoxelNode_AdvancedNoise2D, Value)
 
 		return FVoxelFloatBuffer::MakeCpu(ReturnValue);
 	};
-}
\ No newline at end of file
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+BEGIN_VOXEL_NAMESPACE(MetaGraph)
+
+// Null outputs are not computed
+void ComputeAdvancedNoise3D(
+	const TBufferView<FVector>& Positions,
+	const TBufferView<float>& Times,
+	const TBufferView<float>& Amplitudes,
+	const TBufferView<float>& FeatureScales,
+	const TBufferView<float>& Lacunarities,
+	const TBufferView<float>& Gains,
+	const TBufferView<float>& CellularJitters,
+	TArray<ispc::FOctave>& Octaves,
+	const int32 Seed,
+	const int32 Num,
+	float* ReturnValue,
+	float* ReturnGradientX,
+	float* ReturnGradientY,
+	float* ReturnGradientZ)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	FRandomStream Stream(Seed);
+	for (ispc::FOctave& Octave : Octaves)
+	{
+		const FVector3f Direction = FVector3f(Stream.GetUnitVector());
+		Octave.TimeDirectionX = Direction.X;
+		Octave.TimeDirectionY = Direction.Y;
+		Octave.TimeDirectionZ = Direction.Z;
+	}
+
+	ispc::VoxelNode_AdvancedNoise3D(
+		Positions.X.GetData(),
+		Positions.X.IsConstant(),
+		Positions.Y.GetData(),
+		Positions.Y.IsConstant(),
+		Positions.Z.GetData(),
+		Positions.Z.IsConstant(),
+		Times.GetData(),
+		Times.IsConstant(),
+		Amplitudes.GetData(),
+		Amplitudes.IsConstant(),
+		FeatureScales.GetData(),
+		FeatureScales.IsConstant(),
+		Lacunarities.GetData(),
+		Lacunarities.IsConstant(),
+		Gains.GetData(),
+		Gains.IsConstant(),
+		CellularJitters.GetData(),
+		CellularJitters.IsConstant(),
+		Octaves.GetData(),
+		Octaves.Num(),
+		Seed,
+		ReturnValue != nullptr,
+		ReturnValue,
+		ReturnGradientX != nullptr,
+		ReturnGradientX,
+		ReturnGradientY,
+		ReturnGradientZ,
+		Num);
+}
+
+END_VOXEL_NAMESPACE(MetaGraph)
+
+// No GPU implementation: GPU queries fall back to the CPU one
+DEFINE_VOXEL_NODE_CPU(FVoxelNode_AdvancedNoise3D, Value)
+{
+	const TValue<TBufferView<FVector>> Positions = GetBufferView(PositionPin, Query);
+	const TValue<TBufferView<float>> Times = GetBufferView(TimePin, Query);
+	const TValue<TBufferView<float>> Amplitudes = GetBufferView(AmplitudePin, Query);
+	const TValue<TBufferView<float>> FeatureScales = GetBufferView(FeatureScalePin, Query);
+	const TValue<TBufferView<float>> Lacunarities = GetBufferView(LacunarityPin, Query);
+	const TValue<TBufferView<float>> Gains = GetBufferView(GainPin, Query);
+	const TValue<TBufferView<float>> CellularJitters = GetBufferView(CellularJitterPin, Query);
+	const TValue<int32> NumOctaves = Get(NumOctavesPin, Query);
+	const TValue<int32> Seed = Get(SeedPin, Query);
+	const TValue<uint8> DefaultOctaveType = Get(DefaultOctaveTypePin, Query);
+	const TArray<TValue<uint8>> OctaveTypes = Get(OctaveTypePins, Query);
+	const TArray<TValue<TBufferView<float>>> OctaveStrengths = GetBufferView(OctaveStrengthPins, Query);
+
+	return VOXEL_ON_COMPLETE(AsyncThread, Positions, Times, Amplitudes, FeatureScales, Lacunarities, Gains, CellularJitters, NumOctaves, Seed, DefaultOctaveType, OctaveTypes, OctaveStrengths)
+	{
+		VOXEL_USE_NAMESPACE(MetaGraph);
+
+		const int32 Num = ComputeVoxelBuffersNum(Positions, Times, Amplitudes, FeatureScales, Lacunarities, Gains, CellularJitters);
+
+		TArray<ispc::FOctave> Octaves;
+		if (!BuildOctaves(NumOctaves, DefaultOctaveType, OctaveTypes, OctaveStrengths, Num, Octaves))
+		{
+			RaiseBufferError();
+			return {};
+		}
+
+		TVoxelArray<float> ReturnValue = FVoxelFloatBuffer::Allocate(Num);
+
+		ComputeAdvancedNoise3D(
+			Positions,
+			Times,
+			Amplitudes,
+			FeatureScales,
+			Lacunarities,
+			Gains,
+			CellularJitters,
+			Octaves,
+			Seed,
+			Num,
+			ReturnValue.GetData(),
+			nullptr,
+			nullptr,
+			nullptr);
+
+		return FVoxelFloatBuffer::MakeCpu(ReturnValue);
+	};
+}
+
+DEFINE_VOXEL_NODE_CPU(FVoxelNode_AdvancedNoise3D, Gradient)
+{
+	const TValue<TBufferView<FVector>> Positions = GetBufferView(PositionPin, Query);
+	const TValue<TBufferView<float>> Times = GetBufferView(TimePin, Query);
+	const TValue<TBufferView<float>> Amplitudes = GetBufferView(AmplitudePin, Query);
+	const TValue<TBufferView<float>> FeatureScales = GetBufferView(FeatureScalePin, Query);
+	const TValue<TBufferView<float>> Lacunarities = GetBufferView(LacunarityPin, Query);
+	const TValue<TBufferView<float>> Gains = GetBufferView(GainPin, Query);
+	const TValue<TBufferView<float>> CellularJitters = GetBufferView(CellularJitterPin, Query);
+	const TValue<int32> NumOctaves = Get(NumOctavesPin, Query);
+	const TValue<int32> Seed = Get(SeedPin, Query);
+	const TValue<uint8> DefaultOctaveType = Get(DefaultOctaveTypePin, Query);
+	const TArray<TValue<uint8>> OctaveTypes = Get(OctaveTypePins, Query);
+	const TArray<TValue<TBufferView<float>>> OctaveStrengths = GetBufferView(OctaveStrengthPins, Query);
+
+	return VOXEL_ON_COMPLETE(AsyncThread, Positions, Times, Amplitudes, FeatureScales, Lacunarities, Gains, CellularJitters, NumOctaves, Seed, DefaultOctaveType, OctaveTypes, OctaveStrengths)
+	{
+		VOXEL_USE_NAMESPACE(MetaGraph);
+
+		const int32 Num = ComputeVoxelBuffersNum(Positions, Times, Amplitudes, FeatureScales, Lacunarities, Gains, CellularJitters);
+
+		TArray<ispc::FOctave> Octaves;
+		if (!BuildOctaves(NumOctaves, DefaultOctaveType, OctaveTypes, OctaveStrengths, Num, Octaves))
+		{
+			RaiseBufferError();
+			return {};
+		}
+
+		TVoxelArray<float> ReturnGradientX = FVoxelFloatBuffer::Allocate(Num);
+		TVoxelArray<float> ReturnGradientY = FVoxelFloatBuffer::Allocate(Num);
+		TVoxelArray<float> ReturnGradientZ = FVoxelFloatBuffer::Allocate(Num);
+
+		ComputeAdvancedNoise3D(
+			Positions,
+			Times,
+			Amplitudes,
+			FeatureScales,
+			Lacunarities,
+			Gains,
+			CellularJitters,
+			Octaves,
+			Seed,
+			Num,
+			nullptr,
+			ReturnGradientX.GetData(),
+			ReturnGradientY.GetData(),
+			ReturnGradientZ.GetData());
+
+		return FVoxelVectorBuffer::MakeCpu(ReturnGradientX, ReturnGradientY, ReturnGradientZ);
+	};
+}
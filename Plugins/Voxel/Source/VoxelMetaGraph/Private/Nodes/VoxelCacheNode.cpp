@@ -7,8 +7,19 @@ VOXEL_CONSOLE_VARIABLE(
 	"voxel.metagraph.MaxCacheNodeEntries",
 	"");
 
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, bool, GVoxelMetaGraphSharePinValues, true,
+	"voxel.metagraph.SharePinValues",
+	"If true, nodes such as marching cube mesh, collider and navmesh will share their surface when queried with identical queries");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, float, GVoxelMetaGraphSharedPinValueLifetime, 5.f,
+	"voxel.metagraph.SharedPinValueLifetime",
+	"Time in seconds shared pin values are kept after their last access");
+
 DEFINE_UNIQUE_VOXEL_ID(FVoxelCachedValueId);
 DEFINE_VOXEL_SUBSYSTEM(FVoxelCacheNodeSubsystem);
+DEFINE_VOXEL_SUBSYSTEM(FVoxelSharedPinValueSubsystem);
 
 void FVoxelCacheNodeSubsystem::Cleanup(const TSharedRef<FNodeCache>& NodeCache)
 {
@@ -69,40 +80,26 @@ void FVoxelCacheNodeSubsystem::Cleanup(const TSharedRef<FNodeCache>& NodeCache)
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-DEFINE_VOXEL_NODE(FVoxelNode_Cache, OutData)
+// Shared by the cache node and FVoxelSharedPinValueSubsystem
+// Computes the value if it was never computed or if one of its dependencies was invalidated,
+// and forwards its dependencies to Query
+FVoxelFutureValue GetCachedValue(
+	FVoxelCachedValueRef& CachedValueRef,
+	TVoxelKeyedCriticalSection<FVoxelCachedValueId>& ValueCriticalSection,
+	const FVoxelPinType& Type,
+	const FName StatName,
+	const FVoxelQuery& Query,
+	const TFunctionRef<FVoxelFutureValue(const FVoxelQuery& ChildQuery)> ComputeValue)
 {
-	using FQueryCache = FVoxelCacheNodeSubsystem::FQueryCache;
-	using FNodeCache = FVoxelCacheNodeSubsystem::FNodeCache;
-
-	FVoxelCacheNodeSubsystem& Subsystem = GetSubsystem<FVoxelCacheNodeSubsystem>();
-
-	const FQueryCache::FHashedQuery HashedQuery(Query);
+	VOXEL_FUNCTION_COUNTER();
 
-	TSharedPtr<FNodeCache> NodeCache;
-	TSharedPtr<FVoxelCachedValueRef> CachedValueRef;
+	TUniquePtr<TVoxelFutureValue<FVoxelCachedValue>>& CachedValuePtr = CachedValueRef.Value;
 	{
-		FVoxelScopeLock Lock(Subsystem.CriticalSection);
-
-		NodeCache = Subsystem.NodeCaches.FindOrAdd(this);
-		if (!NodeCache)
-		{
-			NodeCache = Subsystem.NodeCaches.Add(this, MakeShared<FNodeCache>(GetOuter()));
-		}
-
-		CachedValueRef = NodeCache->QueryCache.FindRef(HashedQuery);
-		if (!CachedValueRef)
-		{
-			CachedValueRef = NodeCache->QueryCache.Add(HashedQuery, MakeShared<FVoxelCachedValueRef>());
-		}
-	}
-
-	TUniquePtr<TValue<FVoxelCachedValue>>& CachedValuePtr = CachedValueRef->Value;
-	{
-		TVoxelKeyedScopeLock<FVoxelCachedValueId> ValueLock(Subsystem.ValueCriticalSection, CachedValueRef->Id);
+		TVoxelKeyedScopeLock<FVoxelCachedValueId> ValueLock(ValueCriticalSection, CachedValueRef.Id);
 
 		bool bNeedRecompute = !CachedValuePtr;
 
-		if (CachedValuePtr && 
+		if (CachedValuePtr &&
 			CachedValuePtr->IsComplete())
 		{
 			for (const TSharedPtr<FVoxelDependency>& Dependency : CachedValuePtr->Get_CheckCompleted().Dependencies)
@@ -121,38 +118,192 @@ DEFINE_VOXEL_NODE(FVoxelNode_Cache, OutData)
 			FVoxelQuery ChildQuery = Query;
 			ChildQuery.SetDependenciesQueue(DependenciesQueue);
 
-			const FVoxelFutureValue PinValue = Get(DataPin, ChildQuery);
+			const FVoxelFutureValue PinValue = ComputeValue(ChildQuery);
+
+			CachedValuePtr = MakeUniqueCopy(FVoxelTask::New<FVoxelCachedValue>(
+				MakeShared<FVoxelTaskStat>(),
+				StatName,
+				EVoxelTaskThread::AnyThread,
+				{ PinValue },
+				[DependenciesQueue, PinValue]() -> TVoxelFutureValue<FVoxelCachedValue>
+				{
+					FVoxelCachedValue Value;
+					Value.Value = PinValue.Get_CheckCompleted();
 
-			CachedValuePtr = MakeUniqueCopy(VOXEL_ON_COMPLETE_CUSTOM(FVoxelCachedValue, "Cache", AnyThread, NodeCache, DependenciesQueue, PinValue)
+					TSharedPtr<FVoxelDependency> Dependency;
+					while (DependenciesQueue->Dequeue(Dependency))
+					{
+						Value.Dependencies.Add(Dependency);
+					}
+
+					return Value;
+				}));
+		}
+	}
+	const TVoxelFutureValue<FVoxelCachedValue> CachedValue = *CachedValuePtr;
+
+	return FVoxelTask::New(
+		MakeShared<FVoxelTaskStat>(),
+		Type,
+		StatName,
+		EVoxelTaskThread::AnyThread,
+		{ CachedValue },
+		[CachedValue, Query]() -> FVoxelFutureValue
+		{
+			for (const TSharedPtr<FVoxelDependency>& Dependency : CachedValue.Get_CheckCompleted().Dependencies)
 			{
-				FVoxelCachedValue Value;
-				Value.Value = PinValue;
+				Query.AddDependency(Dependency.ToSharedRef());
+			}
 
-				TSharedPtr<FVoxelDependency> Dependency;
-				while (DependenciesQueue->Dequeue(Dependency))
-				{
-					Value.Dependencies.Add(Dependency);
-				}
+			return CachedValue.Get_CheckCompleted().Value;
+		});
+}
 
-				GetSubsystem<FVoxelCacheNodeSubsystem>().Cleanup(NodeCache.ToSharedRef());
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
 
-				return Value;
-			});
+void FVoxelSharedPinValueSubsystem::Tick()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	Super::Tick();
+
+	const double Time = FPlatformTime::Seconds();
+
+	// Delete the values outside of the lock
+	TVoxelArray<TSharedPtr<FVoxelCachedValueRef>> ValuesToDelete;
+	ON_SCOPE_EXIT
+	{
+		VOXEL_SCOPE_COUNTER("Delete values");
+		ValuesToDelete.Reset();
+	};
+
+	FVoxelScopeLock Lock(CriticalSection);
+
+	for (auto PinIt = PinCaches.CreateIterator(); PinIt; ++PinIt)
+	{
+		FQueryCache& QueryCache = PinIt.Value()->QueryCache;
+
+		TVoxelArray<const FQueryCache::FHashedQuery*> QueriesToRemove;
+		for (const auto& It : QueryCache)
+		{
+			if (It.Value->LastAccessTime + GVoxelMetaGraphSharedPinValueLifetime < Time)
+			{
+				QueriesToRemove.Add(It.Key);
+			}
+		}
+
+		for (const FQueryCache::FHashedQuery* HashedQuery : QueriesToRemove)
+		{
+			ValuesToDelete.Add(QueryCache.FindRef(*HashedQuery));
+			QueryCache.Remove(*HashedQuery);
+		}
+
+		if (QueryCache.Num() == 0)
+		{
+			PinIt.RemoveCurrent();
 		}
 	}
-	const TValue<FVoxelCachedValue> CachedValue = *CachedValuePtr;
+}
 
-	CachedValueRef->LastAccessTime = FPlatformTime::Seconds();
+FVoxelFutureValue FVoxelSharedPinValueSubsystem::Get(const FVoxelNodeRuntime& NodeRuntime, const FVoxelPinRef& Pin, const FVoxelQuery& Query)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	const FVoxelNodeRuntime::FPinData& PinData = NodeRuntime.GetPinData(Pin);
+	if (!GVoxelMetaGraphSharePinValues ||
+		!PinData.OutputPinData)
+	{
+		return NodeRuntime.Get(Pin, Query);
+	}
+
+	const FQueryCache::FHashedQuery HashedQuery(Query);
 
-	return VOXEL_ON_COMPLETE(AnyThread, CachedValue)
+	TSharedPtr<FVoxelCachedValueRef> CachedValueRef;
 	{
-		for (const TSharedPtr<FVoxelDependency>& Dependency : CachedValue->Dependencies)
+		FVoxelScopeLock Lock(CriticalSection);
+
+		TSharedPtr<FPinCache>& PinCache = PinCaches.FindOrAdd(PinData.OutputPinData.Get());
+		if (!PinCache)
 		{
-			Query.AddDependency(Dependency.ToSharedRef());
+			PinCache = MakeShared<FPinCache>(PinData.OutputPinData.ToSharedRef());
 		}
 
-		return CachedValue->Value;
-	};
+		CachedValueRef = PinCache->QueryCache.FindRef(HashedQuery);
+		if (!CachedValueRef)
+		{
+			CachedValueRef = PinCache->QueryCache.Add(HashedQuery, MakeShared<FVoxelCachedValueRef>());
+		}
+
+		// Set under the lock so that Tick doesn't remove it right away
+		CachedValueRef->LastAccessTime = FPlatformTime::Seconds();
+	}
+
+	return GetCachedValue(
+		*CachedValueRef,
+		ValueCriticalSection,
+		PinData.Type,
+		"Share",
+		Query,
+		[&](const FVoxelQuery& ChildQuery)
+		{
+			return NodeRuntime.Get(Pin, ChildQuery);
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+DEFINE_VOXEL_NODE(FVoxelNode_Cache, OutData)
+{
+	using FQueryCache = FVoxelCacheNodeSubsystem::FQueryCache;
+	using FNodeCache = FVoxelCacheNodeSubsystem::FNodeCache;
+
+	FVoxelCacheNodeSubsystem& Subsystem = GetSubsystem<FVoxelCacheNodeSubsystem>();
+
+	const FQueryCache::FHashedQuery HashedQuery(Query);
+
+	TSharedPtr<FNodeCache> NodeCache;
+	TSharedPtr<FVoxelCachedValueRef> CachedValueRef;
+	bool bAdded = false;
+	{
+		FVoxelScopeLock Lock(Subsystem.CriticalSection);
+
+		NodeCache = Subsystem.NodeCaches.FindOrAdd(this);
+		if (!NodeCache)
+		{
+			NodeCache = Subsystem.NodeCaches.Add(this, MakeShared<FNodeCache>(GetOuter()));
+		}
+
+		CachedValueRef = NodeCache->QueryCache.FindRef(HashedQuery);
+		if (!CachedValueRef)
+		{
+			CachedValueRef = NodeCache->QueryCache.Add(HashedQuery, MakeShared<FVoxelCachedValueRef>());
+			bAdded = true;
+		}
+	}
+
+	const FVoxelFutureValue Value = GetCachedValue(
+		*CachedValueRef,
+		Subsystem.ValueCriticalSection,
+		GetNodeRuntime().GetPinData(OutDataPin).Type,
+		"Cache",
+		Query,
+		[&](const FVoxelQuery& ChildQuery)
+		{
+			return Get(DataPin, ChildQuery);
+		});
+
+	CachedValueRef->LastAccessTime = FPlatformTime::Seconds();
+
+	if (bAdded)
+	{
+		Subsystem.Cleanup(NodeCache.ToSharedRef());
+	}
+
+	return Value;
 }
 
 FVoxelPinTypeSet FVoxelNode_Cache::GetPromotionTypes(const FVoxelPin& Pin) const
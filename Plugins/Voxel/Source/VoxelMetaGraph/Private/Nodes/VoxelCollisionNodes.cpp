@@ -20,6 +20,11 @@ void FVoxelChunkExecObject_CreateCollisionComponent::Destroy(FVoxelRuntime& Runt
 	CollisionId = {};
 }
 
+int64 FVoxelChunkExecObject_CreateCollisionComponent::GetAllocatedSize() const
+{
+	return Super::GetAllocatedSize() + (Collider ? Collider->GetAllocatedSize() : 0);
+}
+
 TVoxelFutureValue<FVoxelChunkExecObject> FVoxelChunkExecNode_CreateCollisionComponent::Execute(const FVoxelQuery& Query) const
 {
 	FindVoxelQueryData(FVoxelBoundsQueryData, BoundsQueryData);
@@ -1,6 +1,107 @@
 ﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
 
 #include "Nodes/VoxelCurveNode.h"
+#include "VoxelCurveNodeImpl.ispc.generated.h"
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, float, GVoxelCurveLUTMaxError, 0.001f,
+	"voxel.curve.LUTMaxError",
+	"Max error allowed when baking curves into lookup tables, relative to the curve value range. 0 to disable baking");
+
+void FVoxelCurveData::BakeLUT()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	LUT.Reset();
+
+	if (!Curve ||
+		Curve->GetNumKeys() == 0 ||
+		GVoxelCurveLUTMaxError <= 0.f)
+	{
+		return;
+	}
+
+	const auto IsConstant = [](const ERichCurveExtrapolation Extrapolation)
+	{
+		return
+			Extrapolation == RCCE_Constant ||
+			Extrapolation == RCCE_None;
+	};
+	if (!IsConstant(Curve->PreInfinityExtrap) ||
+		!IsConstant(Curve->PostInfinityExtrap))
+	{
+		return;
+	}
+
+	// Step keys are discontinuous and would never converge
+	for (const FRichCurveKey& Key : Curve->Keys)
+	{
+		if (Key.InterpMode == RCIM_Constant)
+		{
+			return;
+		}
+	}
+
+	Curve->GetTimeRange(LUTMinTime, LUTMaxTime);
+
+	float MinValue;
+	float MaxValue;
+	Curve->GetValueRange(MinValue, MaxValue);
+
+	if (LUTMinTime == LUTMaxTime)
+	{
+		LUT.Add(Curve->Eval(LUTMinTime));
+		LUT.Add(Curve->Eval(LUTMaxTime));
+		return;
+	}
+
+	// Keys can overshoot the value range with their tangents, but it's a good enough scale
+	// If all keys have the same value, tangents can still bend the curve: use the error as an absolute bound
+	const float MaxError = MinValue == MaxValue
+		? GVoxelCurveLUTMaxError
+		: GVoxelCurveLUTMaxError * (MaxValue - MinValue);
+
+	// Double the resolution until every segment is within the error bound
+	constexpr int32 MinLUTSize = 32;
+	constexpr int32 MaxLUTSize = 4096;
+
+	for (int32 NumSegments = MinLUTSize; NumSegments <= MaxLUTSize; NumSegments *= 2)
+	{
+		const float SegmentSize = (LUTMaxTime - LUTMinTime) / NumSegments;
+
+		FVoxelUtilities::SetNumFast(LUT, NumSegments + 1);
+		for (int32 Index = 0; Index <= NumSegments; Index++)
+		{
+			LUT[Index] = Curve->Eval(LUTMinTime + Index * SegmentSize);
+		}
+
+		bool bIsValid = true;
+		for (int32 Index = 0; Index < NumSegments && bIsValid; Index++)
+		{
+			for (const float Alpha : { 0.25f, 0.5f, 0.75f })
+			{
+				const float Value = Curve->Eval(LUTMinTime + (Index + Alpha) * SegmentSize);
+				if (FMath::Abs(FMath::Lerp(LUT[Index], LUT[Index + 1], Alpha) - Value) > MaxError)
+				{
+					bIsValid = false;
+					break;
+				}
+			}
+		}
+
+		if (bIsValid)
+		{
+			return;
+		}
+	}
+
+	// Didn't converge, fallback to Eval
+	LUT.Reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
 
 DEFINE_VOXEL_NODE(FVoxelNode_SampleCurve, Result)
 {
@@ -19,7 +120,22 @@ DEFINE_VOXEL_NODE(FVoxelNode_SampleCurve, Result)
 			}
 
 			TVoxelArray<float> ReturnValue = FVoxelFloatBuffer::Allocate(Value.Num());
-	
+
+			if (Curve->LUT.Num() >= 2 &&
+				!Value.IsConstant())
+			{
+				ispc::VoxelNode_SampleCurve(
+					Value.GetData(),
+					FVoxelBuffer::AlignNum(Value.Num()),
+					Curve->LUT.GetData(),
+					Curve->LUT.Num(),
+					Curve->LUTMinTime,
+					(Curve->LUT.Num() - 1) / FMath::Max(Curve->LUTMaxTime - Curve->LUTMinTime, KINDA_SMALL_NUMBER),
+					ReturnValue.GetData());
+
+				return FVoxelSharedPinValue::Make(FVoxelFloatBuffer::MakeCpu(ReturnValue));
+			}
+
 			for (int32 Index = 0; Index < Value.Num(); Index++)
 			{
 				ReturnValue[Index] = Curve->Curve->Eval(Value[Index]);
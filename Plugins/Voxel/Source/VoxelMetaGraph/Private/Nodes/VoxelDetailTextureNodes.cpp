@@ -17,7 +17,7 @@ DEFINE_VOXEL_NODE_CPU(FVoxelNode_MakeNormalDetailTexture, DetailTexture)
 	return VOXEL_ON_COMPLETE(AsyncThread, DetailTextureQueryData, Normals, Name, MaxNormalDifference, CellNormals)
 	{
 		FindVoxelQueryData(FVoxelPositionQueryData, PositionQueryData);
-		CheckVoxelBuffersNum(Normals, PositionQueryData->GetPositions());
+		CheckVoxelBuffersNum(Normals, *PositionQueryData);
 
 		const TSharedRef<FVoxelDetailTexture> DetailTexture = MakeShared<FVoxelDetailTexture>();
 		DetailTexture->Name = Name;
@@ -77,7 +77,7 @@ DEFINE_VOXEL_NODE_GPU(FVoxelNode_MakeNormalDetailTexture, DetailTexture)
 		VOXEL_USE_NAMESPACE(MetaGraph);
 
 		FindVoxelQueryData(FVoxelPositionQueryData, PositionQueryData);
-		CheckVoxelBuffersNum(Normals, PositionQueryData->GetPositions());
+		CheckVoxelBuffersNum(Normals, *PositionQueryData);
 
 		const FRDGTextureRef Texture = GraphBuilder.CreateTexture(
 			FRDGTextureDesc::Create2D(
@@ -140,7 +140,7 @@ DEFINE_VOXEL_NODE_CPU(FVoxelNode_MakeColorDetailTexture, DetailTexture)
 	return VOXEL_ON_COMPLETE(AsyncThread, DetailTextureQueryData, Colors, Name)
 	{
 		FindVoxelQueryData(FVoxelPositionQueryData, PositionQueryData);
-		CheckVoxelBuffersNum(Colors, PositionQueryData->GetPositions());
+		CheckVoxelBuffersNum(Colors, *PositionQueryData);
 
 		const TSharedRef<FVoxelDetailTexture> DetailTexture = MakeShared<FVoxelDetailTexture>();
 		DetailTexture->Name = Name;
@@ -192,7 +192,7 @@ DEFINE_VOXEL_NODE_GPU(FVoxelNode_MakeColorDetailTexture, DetailTexture)
 		VOXEL_USE_NAMESPACE(MetaGraph);
 
 		FindVoxelQueryData(FVoxelPositionQueryData, PositionQueryData);
-		CheckVoxelBuffersNum(Colors, PositionQueryData->GetPositions());
+		CheckVoxelBuffersNum(Colors, *PositionQueryData);
 
 		const FRDGTextureRef Texture = GraphBuilder.CreateTexture(
 			FRDGTextureDesc::Create2D(
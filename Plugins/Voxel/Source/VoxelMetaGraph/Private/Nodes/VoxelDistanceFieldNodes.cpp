@@ -208,6 +208,51 @@ DEFINE_VOXEL_NODE(FVoxelNode_ComputeDensityFromDistanceField, Density)
 			return FVoxelFloatBuffer::Constant(1e6);
 		}
 
+		{
+			VOXEL_SCOPE_COUNTER("Range");
+
+			// Same merge as below, SmoothMin & SmoothSubtraction are off by at most Smoothness / 4
+			TOptional<FFloatInterval> Range = DistanceFields[0]->GetDistanceRange(Bounds);
+			for (int32 Index = 1; Range && Index < DistanceFields.Num(); Index++)
+			{
+				const FVoxelDistanceField& DistanceField = *DistanceFields[Index];
+
+				const TOptional<FFloatInterval> DistanceRange = DistanceField.GetDistanceRange(Bounds);
+				if (!DistanceRange)
+				{
+					Range.Reset();
+					break;
+				}
+
+				const float Smoothness = FMath::Max(DistanceField.Smoothness, 0.f);
+				if (DistanceField.bIsSubtractive)
+				{
+					Range = FFloatInterval(
+						FMath::Max(Range->Min, -DistanceRange->Max),
+						FMath::Max(Range->Max, -DistanceRange->Min) + Smoothness / 4.f);
+				}
+				else
+				{
+					Range = FFloatInterval(
+						FMath::Min(Range->Min, DistanceRange->Min) - Smoothness / 4.f,
+						FMath::Min(Range->Max, DistanceRange->Max));
+				}
+			}
+
+			// No surface within ExactDistance: skip sampling entirely
+			if (Range)
+			{
+				if (Range->Min > ExactDistance)
+				{
+					return FVoxelFloatBuffer::Constant(Range->Min);
+				}
+				if (Range->Max < -ExactDistance)
+				{
+					return FVoxelFloatBuffer::Constant(Range->Max);
+				}
+			}
+		}
+
 		TArray<TValue<FVoxelFloatBuffer>> AllDistances;
 		for (int32 Index = 0; Index < DistanceFields.Num(); Index++)
 		{
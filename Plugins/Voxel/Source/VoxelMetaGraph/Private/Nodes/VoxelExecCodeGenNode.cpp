@@ -40,6 +40,7 @@ TVoxelFunction<FVoxelFutureValue(const FVoxelQuery&)> FVoxelNode_ExecCodeGen::Co
 
 		FStep& Step = State.Steps.Emplace_GetRef();
 		Step.NodeId = FVoxelNodeCodeGen::GetNodeId(Struct.GetStruct());
+		Step.Node = &Struct;
 		Step.bIsPassthrough = Struct.IsA<FVoxelNode_Passthrough>();
 
 		for (const FVoxelPin& Pin : Struct.GetPins())
@@ -129,6 +130,7 @@ TVoxelFunction<FVoxelFutureValue(const FVoxelQuery&)> FVoxelNode_ExecCodeGen::Co
 	}
 
 	const TSharedRef<FState> SharedState = MakeSharedCopy(State);
+	CompiledState = SharedState;
 
 	ENQUEUE_RENDER_COMMAND(InitializeDefaultBuffers)([=](FRHICommandListImmediate& RHICmdList)
 	{
@@ -309,6 +311,22 @@ FVoxelFutureValue FVoxelNode_ExecCodeGen::ExecuteCpu(
 {
 	VOXEL_FUNCTION_COUNTER();
 
+	if (bIsBuffer)
+	{
+		// Nodes deeper in the callstack still forward their output intervals,
+		// so that the probe can see through runtime nodes such as Query2D
+		const TSharedPtr<const FVoxelUniformSignQueryData> UniformSignQueryData = Query.Find<FVoxelUniformSignQueryData>();
+		if (UniformSignQueryData)
+		{
+			const bool bCheckUniformSign =
+				UniformSignQueryData->IsDirectlyQueried(Query) &&
+				State->OutputRegisters.Num() == 1 &&
+				State->RegisterTypes[State->OutputRegisters[0]].Is<float>();
+
+			return ExecuteUniformSign(Query, State, bCheckUniformSign);
+		}
+	}
+
 	TArray<TValue<FVoxelBufferView>> InputValues;
 	for (int32 Index = 0; Index < GraphInputPins.Num(); Index++)
 	{
@@ -352,7 +370,8 @@ FVoxelFutureValue FVoxelNode_ExecCodeGen::ExecuteCpu(
 FVoxelSharedPinValue FVoxelNode_ExecCodeGen::ExecuteCpu(
 	const TVoxelArray<TSharedPtr<const FVoxelBufferView>>& InputValues,
 	const bool bIsBuffer,
-	const TSharedRef<const FState>& State) const
+	const TSharedRef<const FState>& State,
+	const TVoxelArray<FFloatInterval>* RegisterIntervals) const
 {
 	VOXEL_FUNCTION_COUNTER();
 	
@@ -362,6 +381,60 @@ FVoxelSharedPinValue FVoxelNode_ExecCodeGen::ExecuteCpu(
 		return {};
 	}
 
+	TVoxelArray<FBuffer> InputBuffers;
+	for (const TSharedPtr<const FVoxelBufferView>& InputValue : InputValues)
+	{
+		InputValue->ForeachBufferView([&](const FVoxelTerminalBufferView& BufferView)
+		{
+			FBuffer& Buffer = InputBuffers.Emplace_GetRef();
+			Buffer.Num = BufferView.Num();
+			Buffer.Data = BufferView.GetByteArray();
+		});
+	}
+
+	return ExecuteCpuImpl(Num, InputBuffers, bIsBuffer, State, RegisterIntervals);
+}
+
+FVoxelSharedPinValue FVoxelNode_ExecCodeGen::ExecuteCpuInline(const TVoxelArray<TSharedPtr<const FVoxelBuffer>>& InputValues) const
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (!ensure(CompiledState) ||
+		!ensure(GetPin(OutputPinRef).GetType().IsBuffer()))
+	{
+		return {};
+	}
+
+	int32 Num;
+	if (!CheckBufferSizes(InputValues, Num))
+	{
+		return {};
+	}
+
+	TVoxelArray<FBuffer> InputBuffers;
+	for (const TSharedPtr<const FVoxelBuffer>& InputValue : InputValues)
+	{
+		InputValue->ForeachBuffer([&](const FVoxelTerminalBuffer& TerminalBuffer)
+		{
+			// CPU views are always completed
+			const FVoxelTerminalBufferView& BufferView = TerminalBuffer.MakeView().Get_CheckCompleted();
+
+			FBuffer& Buffer = InputBuffers.Emplace_GetRef();
+			Buffer.Num = BufferView.Num();
+			Buffer.Data = BufferView.GetByteArray();
+		});
+	}
+
+	return ExecuteCpuImpl(Num, InputBuffers, true, CompiledState.ToSharedRef(), nullptr);
+}
+
+FVoxelSharedPinValue FVoxelNode_ExecCodeGen::ExecuteCpuImpl(
+	const int32 Num,
+	const TVoxelArray<FBuffer>& InputBuffers,
+	const bool bIsBuffer,
+	const TSharedRef<const FState>& State,
+	const TVoxelArray<FFloatInterval>* RegisterIntervals) const
+{
 	TVoxelArray<TSharedPtr<FBuffer>> Buffers;
 	for (const FVoxelPinType& Type : State->RegisterTypes)
 	{
@@ -375,17 +448,12 @@ FVoxelSharedPinValue FVoxelNode_ExecCodeGen::ExecuteCpu(
 		*Buffers[It.Key] = It.Value;
 	}
 
+	// Input registers are always allocated first
+	for (int32 Index = 0; Index < InputBuffers.Num(); Index++)
 	{
-		int32 RegisterIndex = 0;
-		for (const TSharedPtr<const FVoxelBufferView>& InputValue : InputValues)
-		{
-			InputValue->ForeachBufferView([&](const FVoxelTerminalBufferView& BufferView)
-			{
-				FBuffer& Buffer = *Buffers[RegisterIndex++];
-				Buffer.Num = BufferView.Num();
-				Buffer.Data = BufferView.GetByteArray();
-			});
-		}
+		FBuffer& Buffer = *Buffers[Index];
+		Buffer.Num = InputBuffers[Index].Num;
+		Buffer.Data = InputBuffers[Index].Data;
 	}
 
 	for (const FStep& Step : State->Steps)
@@ -424,8 +492,15 @@ FVoxelSharedPinValue FVoxelNode_ExecCodeGen::ExecuteCpu(
 	int32 RegisterIndex = 0;
 	ReturnValue.Get<FVoxelBuffer>().ForeachBuffer([&](FVoxelTerminalBuffer& OutBuffer)
 	{
-		const FBuffer& Buffer = *Buffers[State->OutputRegisters[RegisterIndex++]];
+		const int32 Register = State->OutputRegisters[RegisterIndex++];
+		const FBuffer& Buffer = *Buffers[Register];
 		OutBuffer = FVoxelBufferData::MakeCpu(Buffer.InnerType, Buffer.Data.ToSharedRef());
+
+		if (RegisterIntervals &&
+			Buffer.InnerType.Is<float>())
+		{
+			OutBuffer.SetInterval((*RegisterIntervals)[Register]);
+		}
 	});
 	check(ReturnValue.Get<FVoxelBuffer>().Num() == Num);
 
@@ -439,6 +514,234 @@ FVoxelSharedPinValue FVoxelNode_ExecCodeGen::ExecuteCpu(
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+FVoxelFutureValue FVoxelNode_ExecCodeGen::ExecuteUniformSign(
+	const FVoxelQuery& Query,
+	const TSharedRef<const FState>& State,
+	const bool bCheckUniformSign) const
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	TArray<TValue<FVoxelBuffer>> Buffers;
+	for (int32 Index = 0; Index < GraphInputPins.Num(); Index++)
+	{
+		Buffers.Add(GetNodeRuntime().Get<FVoxelBuffer>(InputPinRefs[Index], Query));
+	}
+
+	VOXEL_SETUP_ON_COMPLETE(OutputPinRef);
+
+	return VOXEL_ON_COMPLETE(AnyThread, State, Buffers)
+	{
+		TArray<TValue<FVoxelBufferView>> InputValues;
+		for (const TSharedRef<const FVoxelBuffer>& Buffer : Buffers)
+		{
+			InputValues.Add(Buffer->MakeGenericView());
+		}
+
+		return VOXEL_ON_COMPLETE(AsyncThread, State, bCheckUniformSign, Buffers, InputValues)
+		{
+			TVoxelArray<FFloatInterval> InputIntervals;
+			for (int32 Index = 0; Index < Buffers.Num(); Index++)
+			{
+				TVoxelArray<TOptional<FFloatInterval>> BufferIntervals;
+				Buffers[Index]->ForeachBuffer([&](const FVoxelTerminalBuffer& Buffer)
+				{
+					BufferIntervals.Add(Buffer.GetInterval());
+				});
+
+				int32 BufferIndex = 0;
+				InputValues[Index]->ForeachBufferView([&](const FVoxelTerminalBufferView& BufferView)
+				{
+					const TOptional<FFloatInterval> Interval = BufferIntervals[BufferIndex++];
+					if (Interval)
+					{
+						InputIntervals.Add(FVoxelUtilities::SanitizeInterval(Interval.GetValue()));
+					}
+					else if (BufferView.IsConstant())
+					{
+						InputIntervals.Add(GetConstantInterval(BufferView.GetInnerType(), BufferView.GetByteArray()->GetData()));
+					}
+					else
+					{
+						InputIntervals.Add(FVoxelUtilities::InfiniteInterval());
+					}
+				});
+				check(BufferIndex == BufferIntervals.Num());
+			}
+
+			FFloatInterval Interval;
+			if (bCheckUniformSign &&
+				ComputeUniformSignInterval(*State, InputIntervals, 0, Interval))
+			{
+				// Any value with the right sign will do, no need to compute the actual values
+				const float Value = Interval.Min > 0.f ? Interval.Min : Interval.Max;
+
+				FVoxelPinValue ReturnValue = FVoxelPinValue(GraphOutputPin->Type.GetBufferType());
+				ReturnValue.Get<FVoxelBuffer>().ForeachBuffer([&](FVoxelTerminalBuffer& OutBuffer)
+				{
+					OutBuffer = FVoxelBufferData::MakeConstant(Value);
+				});
+				return FVoxelSharedPinValue(ReturnValue);
+			}
+
+			TVoxelArray<TSharedPtr<const FVoxelBufferView>> InputValuesPtrs;
+			for (const TSharedRef<const FVoxelBufferView>& InputValue : InputValues)
+			{
+				InputValuesPtrs.Add(InputValue);
+			}
+
+			const TVoxelArray<FFloatInterval> RegisterIntervals = ComputeRegisterIntervals(*State, InputIntervals);
+			return ExecuteCpu(InputValuesPtrs, true, State, &RegisterIntervals);
+		};
+	};
+}
+
+FFloatInterval FVoxelNode_ExecCodeGen::ComputeOutputInterval(
+	const FState& State,
+	const TConstVoxelArrayView<FFloatInterval> InputIntervals) const
+{
+	return ComputeRegisterIntervals(State, InputIntervals)[State.OutputRegisters[0]];
+}
+
+TVoxelArray<FFloatInterval> FVoxelNode_ExecCodeGen::ComputeRegisterIntervals(
+	const FState& State,
+	const TConstVoxelArrayView<FFloatInterval> InputIntervals) const
+{
+	TVoxelArray<FFloatInterval> Intervals;
+	Intervals.Init(FVoxelUtilities::InfiniteInterval(), State.RegisterTypes.Num());
+
+	// Input registers are always allocated first
+	for (int32 Index = 0; Index < InputIntervals.Num(); Index++)
+	{
+		Intervals[Index] = InputIntervals[Index];
+	}
+	for (const auto& It : State.DefaultBuffers)
+	{
+		Intervals[It.Key] = GetConstantInterval(It.Value.InnerType, It.Value.Data->GetData());
+	}
+
+	TVoxelArray<FFloatInterval> StepInputs;
+	TVoxelArray<FFloatInterval> StepOutputs;
+	for (const FStep& Step : State.Steps)
+	{
+		if (Step.bIsPassthrough)
+		{
+			for (int32 Index = 0; Index < Step.OutputRegisters.Num(); Index++)
+			{
+				Intervals[Step.OutputRegisters[Index]] = Intervals[Step.InputRegisters[Index]];
+			}
+			continue;
+		}
+
+		StepInputs.Reset();
+		for (const int32 Register : Step.InputRegisters)
+		{
+			StepInputs.Add(Intervals[Register]);
+		}
+
+		StepOutputs.Reset();
+		StepOutputs.Init(FVoxelUtilities::InfiniteInterval(), Step.OutputRegisters.Num());
+
+		if (!Step.Node->ComputeIntervals(StepInputs, StepOutputs))
+		{
+			continue;
+		}
+
+		for (int32 Index = 0; Index < Step.OutputRegisters.Num(); Index++)
+		{
+			Intervals[Step.OutputRegisters[Index]] = FVoxelUtilities::SanitizeInterval(StepOutputs[Index]);
+		}
+	}
+
+	return Intervals;
+}
+
+bool FVoxelNode_ExecCodeGen::ComputeUniformSignInterval(
+	const FState& State,
+	const TConstVoxelArrayView<FFloatInterval> InputIntervals,
+	const int32 Depth,
+	FFloatInterval& OutInterval) const
+{
+	const FFloatInterval Interval = ComputeOutputInterval(State, InputIntervals);
+	if (Interval.Min > 0.f ||
+		Interval.Max < 0.f)
+	{
+		OutInterval = Interval;
+		return true;
+	}
+
+	constexpr int32 MaxDepth = 6;
+	if (Depth >= MaxDepth)
+	{
+		return false;
+	}
+
+	// Interval arithmetic overestimates a lot on large ranges, split the widest input and try again
+	int32 SplitIndex = -1;
+	float SplitSize = 0.f;
+	for (int32 Index = 0; Index < InputIntervals.Num(); Index++)
+	{
+		const FFloatInterval& InputInterval = InputIntervals[Index];
+		if (FVoxelUtilities::IsFiniteInterval(InputInterval) &&
+			InputInterval.Size() > SplitSize)
+		{
+			SplitIndex = Index;
+			SplitSize = InputInterval.Size();
+		}
+	}
+
+	if (SplitIndex == -1)
+	{
+		return false;
+	}
+
+	TVoxelArray<FFloatInterval> SplitIntervals(InputIntervals.GetData(), InputIntervals.Num());
+	const float Middle = (InputIntervals[SplitIndex].Min + InputIntervals[SplitIndex].Max) / 2.f;
+
+	FFloatInterval LowerInterval;
+	SplitIntervals[SplitIndex].Max = Middle;
+	if (!ComputeUniformSignInterval(State, SplitIntervals, Depth + 1, LowerInterval))
+	{
+		return false;
+	}
+
+	FFloatInterval UpperInterval;
+	SplitIntervals[SplitIndex] = FFloatInterval(Middle, InputIntervals[SplitIndex].Max);
+	if (!ComputeUniformSignInterval(State, SplitIntervals, Depth + 1, UpperInterval))
+	{
+		return false;
+	}
+
+	if ((LowerInterval.Min > 0.f) != (UpperInterval.Min > 0.f))
+	{
+		return false;
+	}
+
+	OutInterval = FVoxelUtilities::UnionInterval(LowerInterval, UpperInterval);
+	return true;
+}
+
+FFloatInterval FVoxelNode_ExecCodeGen::GetConstantInterval(const FVoxelPinType& Type, const uint8* Data)
+{
+	if (Type.Is<float>())
+	{
+		return FVoxelUtilities::ConstantInterval(*reinterpret_cast<const float*>(Data));
+	}
+	if (Type.Is<int32>())
+	{
+		return FVoxelUtilities::ConstantInterval(*reinterpret_cast<const int32*>(Data));
+	}
+	if (Type.Is<bool>() ||
+		Type.Is<uint8>())
+	{
+		return FVoxelUtilities::ConstantInterval(*Data);
+	}
+	return FVoxelUtilities::InfiniteInterval();
+}
+
 template<typename T>
 bool FVoxelNode_ExecCodeGen::CheckBufferSizes(
 	const TVoxelArray<TSharedPtr<const T>>& InputValues,
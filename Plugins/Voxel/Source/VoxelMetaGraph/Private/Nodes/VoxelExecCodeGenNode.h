@@ -29,6 +29,10 @@ public:
 	virtual TVoxelFunction<FVoxelFutureValue(const FVoxelQuery&)> Compile(FName PinName) const override;
 	//~ End FVoxelNode Interface
 
+	// Runs the compiled steps right away on CPU buffers, without any query or task
+	// Used by nodes calling the same codegen many times, eg while loops
+	FVoxelSharedPinValue ExecuteCpuInline(const TVoxelArray<TSharedPtr<const FVoxelBuffer>>& InputValues) const;
+
 private:
 	struct FBuffer
 	{
@@ -42,10 +46,12 @@ private:
 	struct FStep
 	{
 		int32 NodeId = 0;
+		const FVoxelNode* Node = nullptr;
 		bool bIsPassthrough = false;
 		TVoxelArray<int32> InputRegisters;
 		TVoxelArray<int32> OutputRegisters;
 	};
+	mutable TSharedPtr<const FState> CompiledState;
 	struct FState
 	{
 		TVoxelArray<FStep> Steps;
@@ -53,6 +59,7 @@ private:
 		TMap<int32, FBuffer> DefaultBuffers;
 		TVoxelArray<int32> OutputRegisters;
 	};
+	mutable TSharedPtr<const FState> CompiledState;
 
 	FVoxelFutureValue ExecuteGpu(
 		const FVoxelQuery& Query,
@@ -68,10 +75,46 @@ private:
 		const bool bIsBuffer,
 		const TSharedRef<const FState>& State) const;
 
+	// If RegisterIntervals is set, float outputs get their interval from it
 	FVoxelSharedPinValue ExecuteCpu(
 		const TVoxelArray<TSharedPtr<const FVoxelBufferView>>& InputValues,
 		const bool bIsBuffer,
-		const TSharedRef<const FState>& State) const;
+		const TSharedRef<const FState>& State,
+		const TVoxelArray<FFloatInterval>* RegisterIntervals = nullptr) const;
+
+	// InputBuffers are the input registers, in order
+	FVoxelSharedPinValue ExecuteCpuImpl(
+		int32 Num,
+		const TVoxelArray<FBuffer>& InputBuffers,
+		bool bIsBuffer,
+		const TSharedRef<const FState>& State,
+		const TVoxelArray<FFloatInterval>* RegisterIntervals) const;
+
+	// Propagates the input intervals to the outputs
+	// If bCheckUniformSign, returns a constant when the output sign is the same everywhere
+	FVoxelFutureValue ExecuteUniformSign(
+		const FVoxelQuery& Query,
+		const TSharedRef<const FState>& State,
+		bool bCheckUniformSign) const;
+
+	// Range of the output register given the range of the input registers
+	FFloatInterval ComputeOutputInterval(
+		const FState& State,
+		TConstVoxelArrayView<FFloatInterval> InputIntervals) const;
+
+	// Range of every register given the range of the input registers
+	TVoxelArray<FFloatInterval> ComputeRegisterIntervals(
+		const FState& State,
+		TConstVoxelArrayView<FFloatInterval> InputIntervals) const;
+
+	// Subdivides the inputs until the output sign is known everywhere, or Depth is too high
+	bool ComputeUniformSignInterval(
+		const FState& State,
+		TConstVoxelArrayView<FFloatInterval> InputIntervals,
+		int32 Depth,
+		FFloatInterval& OutInterval) const;
+
+	static FFloatInterval GetConstantInterval(const FVoxelPinType& Type, const uint8* Data);
 
 	template<typename T>
 	bool CheckBufferSizes(
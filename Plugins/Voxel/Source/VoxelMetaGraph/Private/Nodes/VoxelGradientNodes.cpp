@@ -23,7 +23,7 @@ DEFINE_VOXEL_NODE_GPU(FVoxelNode_GetGradientBase, Gradient)
 				return FVoxelFloatBuffer::Constant(0.f);
 			}
 
-			CheckVoxelBuffersNum(Value, PositionQueryData->GetPositions());
+			CheckVoxelBuffersNum(Value, *PositionQueryData);
 
 			return FVoxelBufferUtilities::GetGradient_Gpu(GraphBuilder, Value, GradientStepQueryData->Step, Stride);
 		};
@@ -78,8 +78,8 @@ DEFINE_VOXEL_NODE_GPU(FVoxelNode_GetGradientBase, Gradient)
 				return FVoxelFloatBuffer::Constant(0.f);
 			}
 
-			const int32 Num = ComputeVoxelBuffersNum(Value, ChildPositionQueryData->GetPositions());
-			ensure(Num == 2 * PositionQueryData->GetPositions().Num());
+			const int32 Num = ComputeVoxelBuffersNum(Value, *ChildPositionQueryData);
+			ensure(Num == 2 * PositionQueryData->Num());
 
 			return FVoxelBufferUtilities::GetGradientCollapse_Gpu(GraphBuilder, Value, GradientStepQueryData->Step);
 		};
@@ -105,7 +105,7 @@ DEFINE_VOXEL_NODE_CPU(FVoxelNode_GetGradientBase, Gradient)
 				return FVoxelFloatBuffer::Constant(0.f);
 			}
 			
-			CheckVoxelBuffersNum(Value, PositionQueryData->GetPositions());
+			CheckVoxelBuffersNum(Value, *PositionQueryData);
 
 			return FVoxelBufferUtilities::GetGradient_Cpu(Value, GradientStepQueryData->Step, Stride);
 		};
@@ -164,8 +164,8 @@ DEFINE_VOXEL_NODE_CPU(FVoxelNode_GetGradientBase, Gradient)
 				return FVoxelFloatBuffer::Constant(0.f);
 			}
 			
-			const int32 Num = ComputeVoxelBuffersNum(Value, ChildPositionQueryData->GetPositions());
-			ensure(Num == 2 * PositionQueryData->GetPositions().Num());
+			const int32 Num = ComputeVoxelBuffersNum(Value, *ChildPositionQueryData);
+			ensure(Num == 2 * PositionQueryData->Num());
 
 			return FVoxelBufferUtilities::GetGradientCollapse_Cpu(Value, GradientStepQueryData->Step);
 		};
@@ -1,6 +1,9 @@
 ﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
 
 #include "Nodes/VoxelLoopNodes.h"
+#include "Nodes/VoxelPositionNodes.h"
+#include "Nodes/VoxelExecCodeGenNode.h"
+#include "VoxelBufferUtilities.h"
 
 VOXEL_CONSOLE_VARIABLE(
 	VOXELMETAGRAPH_API, int32, GVoxelMetaGraphLoopLimit, 100,
@@ -56,8 +59,233 @@ void FVoxelNode_GetWhileLoopPreviousValue::PromotePin(FVoxelPin& Pin, const FVox
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+FVoxelNode_WhileLoop::FVoxelNode_WhileLoop()
+{
+	// Per-lane loops are opt-in
+	GetPin(ContinuePin).SetType(FVoxelPinType::Make<bool>());
+}
+
 DEFINE_VOXEL_NODE(FVoxelNode_WhileLoop, Result)
 {
+	if (AreMathPinsBuffers())
+	{
+		// Per-lane loop: lanes that stop are written to the result and compacted away,
+		// so that the next iterations are only queried on the lanes still running
+		struct FLanes
+		{
+			int32 Num = 0;
+			TVoxelArray<int32> ActiveIndices;
+			FVoxelVectorBuffer ActivePositions;
+			TSharedPtr<FVoxelWhileLoopQueryData> QueryData;
+
+			FVoxelPinType ResultType;
+			// Raw data of each terminal buffer of the result
+			TVoxelArray<TVoxelArray<uint8>> ResultData;
+
+			FVoxelSharedPinValue MakeResult()
+			{
+				FVoxelPinValue Result(ResultType);
+
+				int32 BufferIndex = 0;
+				Result.Get<FVoxelBuffer>().ForeachBuffer([&](FVoxelTerminalBuffer& Buffer)
+				{
+					Buffer = FVoxelBufferData::MakeCpu(Buffer.GetInnerType(), MakeSharedCopy(MoveTemp(ResultData[BufferIndex++])));
+				});
+				return FVoxelSharedPinValue(Result);
+			}
+		};
+
+		if (Query.IsGpu())
+		{
+			VOXEL_MESSAGE(Error, "{0}: Per-lane while loops are not supported on GPU", this);
+			return {};
+		}
+
+		FindVoxelQueryData(FVoxelPositionQueryData, PositionQueryData);
+
+		const FVoxelVectorBuffer Positions = PositionQueryData->GetPositions();
+		const FVoxelFutureValue FirstValue = Get(FirstValuePin, Query);
+
+		if (NativeLoop)
+		{
+			// Loop invariant inputs are queried once on all the lanes, and compacted along with them
+			const auto GetInvariants = [&](const FNativeBody& Body)
+			{
+				FVoxelQuery BodyQuery = Query;
+				BodyQuery.Callstack.Add(Body.Node);
+
+				TArray<TValue<FVoxelBuffer>> Invariants;
+				for (int32 Index = 0; Index < Body.Inputs.Num(); Index++)
+				{
+					if (Body.Inputs[Index] == ENativeInput::Invariant)
+					{
+						Invariants.Add(Body.Node->GetNodeRuntime().Get<FVoxelBuffer>(Body.Node->InputPinRefs[Index], BodyQuery));
+					}
+				}
+				return Invariants;
+			};
+
+			const int32 NumLanes = Positions.Num();
+			const TArray<TValue<FVoxelBuffer>> ContinueInvariants = GetInvariants(NativeLoop->Continue);
+			const TArray<TValue<FVoxelBuffer>> NextValueInvariants = GetInvariants(NativeLoop->NextValue);
+
+			return VOXEL_ON_COMPLETE(AsyncThread, NumLanes, FirstValue, ContinueInvariants, NextValueInvariants)
+			{
+				return RunNativeLoop(NumLanes, FirstValue, ContinueInvariants, NextValueInvariants);
+			};
+		}
+
+		return VOXEL_ON_COMPLETE(AnyThread, Positions, FirstValue)
+		{
+			const TSharedRef<FLanes> Lanes = MakeShared<FLanes>();
+			Lanes->Num = Positions.Num();
+			Lanes->ActivePositions = Positions;
+			Lanes->ResultType = FirstValue.GetType();
+
+			FVoxelUtilities::SetNumFast(Lanes->ActiveIndices, Lanes->Num);
+			for (int32 Index = 0; Index < Lanes->Num; Index++)
+			{
+				Lanes->ActiveIndices[Index] = Index;
+			}
+
+			FirstValue.Get<FVoxelBuffer>().ForeachBuffer([&](const FVoxelTerminalBuffer& Buffer)
+			{
+				Lanes->ResultData.Add(FVoxelBuffer::AllocateRaw(Lanes->Num, Buffer.GetInnerType().GetTypeSize()));
+			});
+
+			Lanes->QueryData = MakeShared<FVoxelWhileLoopQueryData>();
+			Lanes->QueryData->Index = 0;
+			Lanes->QueryData->Value = FirstValue;
+
+			const TSharedRef<TFunction<FVoxelFutureValue()>> Function = MakeShared<TFunction<FVoxelFutureValue()>>();
+
+			*Function = [VOXEL_ON_COMPLETE_CAPTURE, Function, Lanes]
+			{
+				FVoxelQuery ChildQuery = Query;
+				ChildQuery.Add(Lanes->QueryData.ToSharedRef());
+				ChildQuery.Add<FVoxelSparsePositionQueryData>().Initialize(Lanes->ActivePositions);
+
+				const TValue<TBufferView<bool>> Continue = GetBufferView<bool>(ContinuePin, ChildQuery);
+				const TValue<TBufferView<FVector>> ActivePositions = Lanes->ActivePositions.MakeView();
+				const TValue<FVoxelBufferView> ActiveValue = Lanes->QueryData->Value.Get<FVoxelBuffer>().MakeGenericView();
+
+				return VOXEL_ON_COMPLETE(AsyncThread, Function, Lanes, Continue, ActivePositions, ActiveValue)
+				{
+					const int32 NumActive = Lanes->ActiveIndices.Num();
+					if (!Continue.IsConstant() &&
+						Continue.Num() != NumActive)
+					{
+						RaiseBufferError();
+						return {};
+					}
+
+					const FVoxelBuffer& ActiveValueBuffer = Lanes->QueryData->Value.Get<FVoxelBuffer>();
+
+					{
+						VOXEL_SCOPE_COUNTER("Scatter");
+
+						// Write the lanes that finished this iteration. The first iteration writes all the lanes,
+						// so that lanes that are never written again keep their first value
+						TVoxelArray<int32> WriteIndices;
+						FVoxelUtilities::SetNumFast(WriteIndices, NumActive);
+						for (int32 Index = 0; Index < NumActive; Index++)
+						{
+							const bool bFinished =
+								Lanes->QueryData->Index == 0 ||
+								!(Continue.IsConstant() ? Continue.GetConstant() : Continue[Index]);
+
+							WriteIndices[Index] = bFinished ? Lanes->ActiveIndices[Index] : -1;
+						}
+
+						bool bIsValid = true;
+						int32 BufferIndex = 0;
+						ActiveValueBuffer.ForeachBuffer([&](const FVoxelTerminalBuffer& ValueBuffer)
+						{
+							bIsValid &= FVoxelBufferUtilities::Scatter_Cpu(
+								Lanes->ResultData[BufferIndex++],
+								ValueBuffer.MakeView().Get_CheckCompleted(),
+								WriteIndices);
+						});
+
+						if (!bIsValid)
+						{
+							RaiseBufferError();
+							return {};
+						}
+					}
+
+					if (Continue.IsConstant())
+					{
+						if (!Continue.GetConstant())
+						{
+							return Lanes->MakeResult();
+						}
+					}
+					else
+					{
+						VOXEL_SCOPE_COUNTER("Compact");
+
+						TVoxelArray<int32> ActiveIndices;
+						TVoxelArray<float> X;
+						TVoxelArray<float> Y;
+						TVoxelArray<float> Z;
+						ActiveIndices.Reserve(NumActive);
+						X.Reserve(FVoxelBuffer::AlignNum(NumActive));
+						Y.Reserve(FVoxelBuffer::AlignNum(NumActive));
+						Z.Reserve(FVoxelBuffer::AlignNum(NumActive));
+
+						for (int32 Index = 0; Index < NumActive; Index++)
+						{
+							if (!Continue[Index])
+							{
+								continue;
+							}
+
+							ActiveIndices.Add_NoGrow(Lanes->ActiveIndices[Index]);
+							X.Add_NoGrow(ActivePositions.X[Index]);
+							Y.Add_NoGrow(ActivePositions.Y[Index]);
+							Z.Add_NoGrow(ActivePositions.Z[Index]);
+						}
+
+						if (ActiveIndices.Num() == 0)
+						{
+							return Lanes->MakeResult();
+						}
+
+						if (ActiveIndices.Num() != NumActive)
+						{
+							Lanes->ActiveIndices = MoveTemp(ActiveIndices);
+							Lanes->ActivePositions = FVoxelVectorBuffer::MakeCpu(X, Y, Z);
+							Lanes->QueryData->Value = FilterLanes(Lanes->QueryData->Value, Continue);
+						}
+					}
+
+					if (Lanes->QueryData->Index > GVoxelMetaGraphLoopLimit)
+					{
+						VOXEL_MESSAGE(Error, "{0}: Loop limit of {1} reached", this, GVoxelMetaGraphLoopLimit);
+						return {};
+					}
+
+					FVoxelQuery ChildQuery = Query;
+					ChildQuery.Add(Lanes->QueryData.ToSharedRef());
+					ChildQuery.Add<FVoxelSparsePositionQueryData>().Initialize(Lanes->ActivePositions);
+
+					const FVoxelFutureValue NextValue = Get(NextValuePin, ChildQuery);
+
+					return VOXEL_ON_COMPLETE(AnyThread, Function, Lanes, NextValue)
+					{
+						Lanes->QueryData->Index++;
+						Lanes->QueryData->Value = NextValue;
+
+						return (*Function)();
+					};
+				};
+			};
+
+			return (*Function)();
+		};
+	}
+
 	const FVoxelFutureValue FirstValue = Get(FirstValuePin, Query);
 
 	return VOXEL_ON_COMPLETE(AnyThread, FirstValue)
@@ -73,7 +301,7 @@ DEFINE_VOXEL_NODE(FVoxelNode_WhileLoop, Result)
 
 		*Function = [VOXEL_ON_COMPLETE_CAPTURE, Function, QueryData, ChildQuery]
 		{
-			const TValue<bool> Continue = Get(ContinuePin, ChildQuery);
+			const TValue<bool> Continue = Get<bool>(ContinuePin, ChildQuery);
 
 			return VOXEL_ON_COMPLETE(AnyThread, Function, QueryData, ChildQuery, Continue)
 			{
@@ -104,14 +332,355 @@ DEFINE_VOXEL_NODE(FVoxelNode_WhileLoop, Result)
 	};
 }
 
+void FVoxelNode_WhileLoop::Initialize()
+{
+	Super::Initialize();
+
+	if (!AreMathPinsBuffers())
+	{
+		return;
+	}
+
+	const TSharedRef<FNativeLoop> Loop = MakeShared<FNativeLoop>();
+	if (!MakeNativeBody(ContinuePin, Loop->Continue) ||
+		!MakeNativeBody(NextValuePin, Loop->NextValue))
+	{
+		return;
+	}
+
+	NativeLoop = Loop;
+}
+
 FVoxelPinTypeSet FVoxelNode_WhileLoop::GetPromotionTypes(const FVoxelPin& Pin) const
 {
+	if (Pin.Name == ContinuePin)
+	{
+		return Super::GetPromotionTypes(Pin);
+	}
+
 	return FVoxelPinTypeSet::All();
 }
 
 void FVoxelNode_WhileLoop::PromotePin(FVoxelPin& Pin, const FVoxelPinType& NewType)
 {
+	if (Pin.Name == ContinuePin)
+	{
+		Super::PromotePin(Pin, NewType);
+		return;
+	}
+
 	GetPin(FirstValuePin).SetType(NewType);
 	GetPin(NextValuePin).SetType(NewType);
 	GetPin(ResultPin).SetType(NewType);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool FVoxelNode_WhileLoop::MakeNativeBody(const FVoxelPinRef& Pin, FNativeBody& OutBody) const
+{
+	const FVoxelNodeRuntime::FPinData& PinData = GetNodeRuntime().GetPinData(Pin);
+	if (!PinData.OutputPinData ||
+		!PinData.OutputPinData->ComputeState ||
+		!PinData.OutputPinData->ComputeState->Node->IsA<FVoxelNode_ExecCodeGen>())
+	{
+		return false;
+	}
+
+	const FVoxelNode_ExecCodeGen& Node = static_cast<const FVoxelNode_ExecCodeGen&>(*PinData.OutputPinData->ComputeState->Node);
+	if (!Node.GetPin(Node.OutputPinRef).GetType().IsBuffer())
+	{
+		return false;
+	}
+
+	const FVoxelPinType ValueType = GetNodeRuntime().GetPinData(FirstValuePin).Type;
+
+	OutBody.Node = &Node;
+	for (const FVoxelPinRef& InputPin : Node.InputPinRefs)
+	{
+		const FVoxelNodeRuntime::FPinData& InputPinData = Node.GetNodeRuntime().GetPinData(InputPin);
+		if (!InputPinData.OutputPinData ||
+			!InputPinData.OutputPinData->ComputeState)
+		{
+			return false;
+		}
+
+		const FVoxelNode& InputNode = *InputPinData.OutputPinData->ComputeState->Node;
+		if (InputNode.IsA<FVoxelNode_GetWhileLoopPreviousValue>())
+		{
+			if (InputPinData.Type != ValueType)
+			{
+				return false;
+			}
+
+			OutBody.Inputs.Add(ENativeInput::Value);
+			continue;
+		}
+		if (InputNode.IsA<FVoxelNode_GetWhileLoopIndex>())
+		{
+			if (!InputPinData.Type.Is<FVoxelInt32Buffer>())
+			{
+				return false;
+			}
+
+			OutBody.Inputs.Add(ENativeInput::Index);
+			continue;
+		}
+
+		TSet<const FVoxelNode*> VisitedNodes;
+		if (DependsOnLoop(InputNode, VisitedNodes))
+		{
+			return false;
+		}
+
+		OutBody.Inputs.Add(ENativeInput::Invariant);
+	}
+
+	return true;
+}
+
+bool FVoxelNode_WhileLoop::DependsOnLoop(const FVoxelNode& Node, TSet<const FVoxelNode*>& VisitedNodes)
+{
+	if (VisitedNodes.Contains(&Node))
+	{
+		return false;
+	}
+	VisitedNodes.Add(&Node);
+
+	// Nested loops are conservatively considered as depending on this one
+	if (Node.IsA<FVoxelNode_GetWhileLoopPreviousValue>() ||
+		Node.IsA<FVoxelNode_GetWhileLoopIndex>() ||
+		Node.IsA<FVoxelNode_WhileLoop>())
+	{
+		return true;
+	}
+
+	for (const FVoxelPin& Pin : Node.GetPins())
+	{
+		if (!Pin.bIsInput)
+		{
+			continue;
+		}
+
+		const FVoxelNodeRuntime::FPinData& PinData = Node.GetNodeRuntime().GetPinData(Pin.Name);
+		if (PinData.OutputPinData &&
+			PinData.OutputPinData->ComputeState &&
+			DependsOnLoop(*PinData.OutputPinData->ComputeState->Node, VisitedNodes))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FVoxelSharedPinValue FVoxelNode_WhileLoop::RunNativeLoop(
+	const int32 NumLanes,
+	const FVoxelSharedPinValue& FirstValue,
+	const TArray<TSharedRef<const FVoxelBuffer>>& ContinueInvariants,
+	const TArray<TSharedRef<const FVoxelBuffer>>& NextValueInvariants) const
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(NativeLoop);
+
+	bool bIsValid = true;
+	const auto MakeInvariants = [&](const TArray<TSharedRef<const FVoxelBuffer>>& Buffers)
+	{
+		TVoxelArray<FVoxelSharedPinValue> Invariants;
+		for (const TSharedRef<const FVoxelBuffer>& Buffer : Buffers)
+		{
+			// Invariants are compacted along with the lanes, so they need to be per-lane or constant
+			Buffer->ForeachBuffer([&](const FVoxelTerminalBuffer& TerminalBuffer)
+			{
+				bIsValid &= TerminalBuffer.Num() == 1 || TerminalBuffer.Num() == NumLanes;
+			});
+
+			Invariants.Add(FVoxelSharedPinValue::Make<FVoxelBuffer>(Buffer));
+		}
+		return Invariants;
+	};
+
+	TVoxelArray<FVoxelSharedPinValue> ActiveContinueInvariants = MakeInvariants(ContinueInvariants);
+	TVoxelArray<FVoxelSharedPinValue> ActiveNextValueInvariants = MakeInvariants(NextValueInvariants);
+
+	if (!bIsValid)
+	{
+		FVoxelNodeHelpers::RaiseBufferError(*this);
+		return {};
+	}
+
+	TVoxelArray<int32> ActiveIndices;
+	FVoxelUtilities::SetNumFast(ActiveIndices, NumLanes);
+	for (int32 Index = 0; Index < NumLanes; Index++)
+	{
+		ActiveIndices[Index] = Index;
+	}
+
+	// Raw data of each terminal buffer of the result
+	TVoxelArray<TVoxelArray<uint8>> ResultData;
+	FirstValue.Get<FVoxelBuffer>().ForeachBuffer([&](const FVoxelTerminalBuffer& Buffer)
+	{
+		ResultData.Add(FVoxelBuffer::AllocateRaw(NumLanes, Buffer.GetInnerType().GetTypeSize()));
+	});
+
+	const auto MakeResult = [&]
+	{
+		FVoxelPinValue Result(FirstValue.GetType());
+
+		int32 BufferIndex = 0;
+		Result.Get<FVoxelBuffer>().ForeachBuffer([&](FVoxelTerminalBuffer& Buffer)
+		{
+			Buffer = FVoxelBufferData::MakeCpu(Buffer.GetInnerType(), MakeSharedCopy(MoveTemp(ResultData[BufferIndex++])));
+		});
+		return FVoxelSharedPinValue(Result);
+	};
+
+	FVoxelSharedPinValue Value = FirstValue;
+
+	const auto Execute = [&](const FNativeBody& Body, const TVoxelArray<FVoxelSharedPinValue>& Invariants, const int32 LoopIndex)
+	{
+		TVoxelArray<TSharedPtr<const FVoxelBuffer>> Inputs;
+		int32 InvariantIndex = 0;
+		for (const ENativeInput Input : Body.Inputs)
+		{
+			switch (Input)
+			{
+			default: ensure(false);
+			case ENativeInput::Value:
+			{
+				Inputs.Add(Value.GetSharedStruct<FVoxelBuffer>());
+			}
+			break;
+			case ENativeInput::Index:
+			{
+				Inputs.Add(MakeSharedCopy(FVoxelInt32Buffer::Constant(LoopIndex)));
+			}
+			break;
+			case ENativeInput::Invariant:
+			{
+				Inputs.Add(Invariants[InvariantIndex++].GetSharedStruct<FVoxelBuffer>());
+			}
+			break;
+			}
+		}
+		return Body.Node->ExecuteCpuInline(Inputs);
+	};
+
+	for (int32 LoopIndex = 0; ; LoopIndex++)
+	{
+		const int32 NumActive = ActiveIndices.Num();
+
+		const FVoxelSharedPinValue ContinueValue = Execute(NativeLoop->Continue, ActiveContinueInvariants, LoopIndex);
+		if (!ContinueValue.IsValid())
+		{
+			return {};
+		}
+
+		const TVoxelBufferView<bool> Continue = ContinueValue.Get<FVoxelBoolBuffer>().MakeView().Get_CheckCompleted();
+		if (!Continue.IsConstant() &&
+			Continue.Num() != NumActive)
+		{
+			FVoxelNodeHelpers::RaiseBufferError(*this);
+			return {};
+		}
+
+		{
+			VOXEL_SCOPE_COUNTER("Scatter");
+
+			// Same as the queried loop: the first iteration writes all the lanes
+			TVoxelArray<int32> WriteIndices;
+			FVoxelUtilities::SetNumFast(WriteIndices, NumActive);
+			for (int32 Index = 0; Index < NumActive; Index++)
+			{
+				const bool bFinished =
+					LoopIndex == 0 ||
+					!(Continue.IsConstant() ? Continue.GetConstant() : Continue[Index]);
+
+				WriteIndices[Index] = bFinished ? ActiveIndices[Index] : -1;
+			}
+
+			int32 BufferIndex = 0;
+			Value.Get<FVoxelBuffer>().ForeachBuffer([&](const FVoxelTerminalBuffer& ValueBuffer)
+			{
+				bIsValid &= FVoxelBufferUtilities::Scatter_Cpu(
+					ResultData[BufferIndex++],
+					ValueBuffer.MakeView().Get_CheckCompleted(),
+					WriteIndices);
+			});
+
+			if (!bIsValid)
+			{
+				FVoxelNodeHelpers::RaiseBufferError(*this);
+				return {};
+			}
+		}
+
+		if (Continue.IsConstant())
+		{
+			if (!Continue.GetConstant())
+			{
+				return MakeResult();
+			}
+		}
+		else
+		{
+			VOXEL_SCOPE_COUNTER("Compact");
+
+			TVoxelArray<int32> NewActiveIndices;
+			NewActiveIndices.Reserve(NumActive);
+
+			for (int32 Index = 0; Index < NumActive; Index++)
+			{
+				if (Continue[Index])
+				{
+					NewActiveIndices.Add_NoGrow(ActiveIndices[Index]);
+				}
+			}
+
+			if (NewActiveIndices.Num() == 0)
+			{
+				return MakeResult();
+			}
+
+			if (NewActiveIndices.Num() != NumActive)
+			{
+				ActiveIndices = MoveTemp(NewActiveIndices);
+				Value = FilterLanes(Value, Continue);
+
+				for (TVoxelArray<FVoxelSharedPinValue>* Invariants : { &ActiveContinueInvariants, &ActiveNextValueInvariants })
+				{
+					for (FVoxelSharedPinValue& Invariant : *Invariants)
+					{
+						if (Invariant.Get<FVoxelBuffer>().Num() != 1)
+						{
+							Invariant = FilterLanes(Invariant, Continue);
+						}
+					}
+				}
+			}
+		}
+
+		if (LoopIndex > GVoxelMetaGraphLoopLimit)
+		{
+			VOXEL_MESSAGE(Error, "{0}: Loop limit of {1} reached", this, GVoxelMetaGraphLoopLimit);
+			return {};
+		}
+
+		Value = Execute(NativeLoop->NextValue, ActiveNextValueInvariants, LoopIndex);
+		if (!Value.IsValid())
+		{
+			return {};
+		}
+	}
+}
+
+FVoxelSharedPinValue FVoxelNode_WhileLoop::FilterLanes(const FVoxelSharedPinValue& Value, const FVoxelBoolBufferView& Condition)
+{
+	FVoxelPinValue Result(Value.MakeValue());
+	Result.Get<FVoxelBuffer>().ForeachBufferPair(Value.Get<FVoxelBuffer>(), [&](FVoxelTerminalBuffer& OutBuffer, const FVoxelTerminalBuffer& Buffer)
+	{
+		OutBuffer = FVoxelBufferUtilities::Filter_Cpu(Buffer.MakeView().Get_CheckCompleted(), Condition);
+	});
+	return FVoxelSharedPinValue(Result);
 }
\ No newline at end of file
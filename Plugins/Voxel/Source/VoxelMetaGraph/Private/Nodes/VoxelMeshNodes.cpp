@@ -13,7 +13,7 @@ DEFINE_VOXEL_NODE(FVoxelNode_MakeVertexData, VertexData)
 
 	return VOXEL_ON_COMPLETE(AsyncThread, PositionQueryData, Normals, Colors, TextureCoordinates)
 	{
-		const int32 Num = ComputeVoxelBuffersNum(PositionQueryData->GetPositions(), Normals, Colors);
+		const int32 Num = ComputeVoxelBuffersNum(*PositionQueryData, Normals, Colors);
 		
 		const TSharedRef<FVoxelVertexData> VertexData = MakeShared<FVoxelVertexData>();
 		FVoxelUtilities::SetNumFast(VertexData->Normals, Num);
@@ -27,7 +27,7 @@ DEFINE_VOXEL_NODE(FVoxelNode_MakeVertexData, VertexData)
 
 		for (const TBufferView<FVector2D>& TextureCoordinate : TextureCoordinates)
 		{
-			CheckVoxelBuffersNum(PositionQueryData->GetPositions(), TextureCoordinate);
+			CheckVoxelBuffersNum(*PositionQueryData, TextureCoordinate);
 
 			TVoxelArray<FVector2f>& NewTextureCoordinate = VertexData->AllTextureCoordinates.Emplace_GetRef();
 			FVoxelUtilities::SetNumFast(NewTextureCoordinate, Num);
@@ -64,6 +64,11 @@ void FVoxelChunkExecObject_CreateMeshComponent::Destroy(FVoxelRuntime& Runtime)
 	MeshId = {};
 }
 
+int64 FVoxelChunkExecObject_CreateMeshComponent::GetAllocatedSize() const
+{
+	return Super::GetAllocatedSize() + (Mesh ? Mesh->GetAllocatedSize() : 0);
+}
+
 TVoxelFutureValue<FVoxelChunkExecObject> FVoxelChunkExecNode_CreateMeshComponent::Execute(const FVoxelQuery& Query) const
 {
 	FindVoxelQueryData(FVoxelBoundsQueryData, BoundsQueryData);
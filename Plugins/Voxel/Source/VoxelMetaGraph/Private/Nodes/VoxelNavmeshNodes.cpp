@@ -4,13 +4,13 @@
 
 void FVoxelChunkExecObject_CreateNavmeshComponent::Create(FVoxelRuntime& Runtime) const
 {
-	if (!ensure(Navmesh))
+	if (!ensure(NavmeshCells.Num() > 0))
 	{
 		return;
 	}
 
 	ensure(!NavmeshId.IsValid());
-	NavmeshId = Runtime.GetSubsystem<FVoxelNavmeshProcessor>().CreateNavmesh(Position, Navmesh.ToSharedRef());
+	NavmeshId = Runtime.GetSubsystem<FVoxelNavmeshProcessor>().CreateNavmesh(Bounds, NavmeshCells);
 }
 
 void FVoxelChunkExecObject_CreateNavmeshComponent::Destroy(FVoxelRuntime& Runtime) const
@@ -20,6 +20,16 @@ void FVoxelChunkExecObject_CreateNavmeshComponent::Destroy(FVoxelRuntime& Runtim
 	NavmeshId = {};
 }
 
+int64 FVoxelChunkExecObject_CreateNavmeshComponent::GetAllocatedSize() const
+{
+	int64 AllocatedSize = Super::GetAllocatedSize() + NavmeshCells.GetAllocatedSize();
+	for (const auto& It : NavmeshCells)
+	{
+		AllocatedSize += It.Value->GetAllocatedSize();
+	}
+	return AllocatedSize;
+}
+
 TVoxelFutureValue<FVoxelChunkExecObject> FVoxelChunkExecNode_CreateNavmeshComponent::Execute(const FVoxelQuery& Query) const
 {
 	FindVoxelQueryData(FVoxelBoundsQueryData, BoundsQueryData);
@@ -33,8 +43,13 @@ TVoxelFutureValue<FVoxelChunkExecObject> FVoxelChunkExecNode_CreateNavmeshCompon
 		}
 
 		const TSharedRef<FVoxelChunkExecObject_CreateNavmeshComponent> Object = MakeShared<FVoxelChunkExecObject_CreateNavmeshComponent>();
-		Object->Position = BoundsQueryData->Bounds.Min;
-		Object->Navmesh = Navmesh;
+		Object->Bounds = BoundsQueryData->Bounds;
+		Object->NavmeshCells = FVoxelNavmeshProcessor::PrepareNavmesh(*Navmesh);
+
+		if (Object->NavmeshCells.Num() == 0)
+		{
+			return {};
+		}
 		return Object;
 	};
 }
\ No newline at end of file
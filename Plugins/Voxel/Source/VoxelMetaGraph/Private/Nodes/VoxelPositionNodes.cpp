@@ -2,6 +2,7 @@
 
 #include "Nodes/VoxelPositionNodes.h"
 #include "VoxelBufferUtilities.h"
+#include "Nodes/VoxelExecCodeGenNode.h"
 #include "VoxelMetaGraphRuntimeUtilities.h"
 
 void FVoxelGradientPositionQueryData::Initialize(
@@ -90,6 +91,37 @@ END_VOXEL_SHADER()
 
 END_VOXEL_NAMESPACE(MetaGraph)
 
+FVoxelVectorBuffer FVoxelDensePositionQueryData::GetPositions() const
+{
+	VOXEL_SCOPE_LOCK(CriticalSection);
+
+	if (CachedPositions_RequiresLock)
+	{
+		return CachedPositions_RequiresLock.GetValue();
+	}
+
+	VOXEL_FUNCTION_COUNTER();
+	VOXEL_USE_NAMESPACE(MetaGraph);
+
+	TVoxelArray<float> WriteX = FVoxelFloatBuffer::Allocate(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
+	TVoxelArray<float> WriteY = FVoxelFloatBuffer::Allocate(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
+	TVoxelArray<float> WriteZ = FVoxelFloatBuffer::Allocate(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
+
+	FRuntimeUtilities::WritePositions(
+		WriteX,
+		WriteY,
+		WriteZ,
+		PrivateStart,
+		PrivateStep,
+		PrivateSize);
+
+	FVoxelVectorBuffer Positions = FVoxelVectorBuffer::MakeCpu(WriteX, WriteY, WriteZ);
+	Positions.SetBounds(GetBounds());
+
+	CachedPositions_RequiresLock = Positions;
+	return Positions;
+}
+
 void FVoxelDensePositionQueryData::Initialize(
 	const FVector3f& Start,
 	const float Step,
@@ -107,72 +139,59 @@ void FVoxelDensePositionQueryData::Initialize(
 		PrivateSize = PrivateSize + 1;
 	}
 
-	if (IsInRenderingThread())
+	VOXEL_SCOPE_LOCK(CriticalSection);
+	CachedPositions_RequiresLock.Reset();
+
+	if (!IsInRenderingThread())
 	{
-		CachedPositions.X = FVoxelFloatBuffer::MakeGpu(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
-		CachedPositions.Y = FVoxelFloatBuffer::MakeGpu(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
-		CachedPositions.Z = FVoxelFloatBuffer::MakeGpu(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
+		// CPU positions are only written if someone asks for them
+		return;
+	}
 
-		FRDGBuilder& GraphBuilder = FVoxelRDGBuilderScope::Get();
+	FVoxelVectorBuffer Positions;
+	Positions.X = FVoxelFloatBuffer::MakeGpu(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
+	Positions.Y = FVoxelFloatBuffer::MakeGpu(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
+	Positions.Z = FVoxelFloatBuffer::MakeGpu(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
 
-		BEGIN_VOXEL_SHADER_CALL(WritePositions)
-		{
-			ensure(PrivateSize % 2 == 0);
-			const FIntVector BlockSize = FIntVector(PrivateSize) / 2;
+	FRDGBuilder& GraphBuilder = FVoxelRDGBuilderScope::Get();
 
-			Parameters.Start = Start;
-			Parameters.Step = Step;
-			Parameters.BlockSize = BlockSize;
+	BEGIN_VOXEL_SHADER_CALL(WritePositions)
+	{
+		ensure(PrivateSize % 2 == 0);
+		const FIntVector BlockSize = FIntVector(PrivateSize) / 2;
 
-			Parameters.OutPositionX = CachedPositions.X.GetGpuBuffer();
-			Parameters.OutPositionY = CachedPositions.Y.GetGpuBuffer();
-			Parameters.OutPositionZ = CachedPositions.Z.GetGpuBuffer();
+		Parameters.Start = Start;
+		Parameters.Step = Step;
+		Parameters.BlockSize = BlockSize;
 
-			Execute(FComputeShaderUtils::GetGroupCount(BlockSize, 4));
-		}
-		END_VOXEL_SHADER_CALL()
-	}
-	else
-	{
-		TVoxelArray<float> WriteX = FVoxelFloatBuffer::Allocate(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
-		TVoxelArray<float> WriteY = FVoxelFloatBuffer::Allocate(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
-		TVoxelArray<float> WriteZ = FVoxelFloatBuffer::Allocate(PrivateSize.X * PrivateSize.Y * PrivateSize.Z);
-
-		FRuntimeUtilities::WritePositions(
-			WriteX,
-			WriteY,
-			WriteZ,
-			PrivateStart,
-			PrivateStep,
-			PrivateSize);
-
-		CachedPositions = FVoxelVectorBuffer::MakeCpu(WriteX, WriteY, WriteZ);
+		Parameters.OutPositionX = Positions.X.GetGpuBuffer();
+		Parameters.OutPositionY = Positions.Y.GetGpuBuffer();
+		Parameters.OutPositionZ = Positions.Z.GetGpuBuffer();
+
+		Execute(FComputeShaderUtils::GetGroupCount(BlockSize, 4));
 	}
+	END_VOXEL_SHADER_CALL()
 
-	CachedPositions.SetBounds(GetBounds());
+	Positions.SetBounds(GetBounds());
+	CachedPositions_RequiresLock = Positions;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void FVoxelDense2DPositionQueryData::Initialize(
-	const FVector2f& Start,
-	const float Step,
-	const FIntPoint& Size)
+FVoxelVectorBuffer FVoxelDense2DPositionQueryData::GetPositions() const
 {
-	VOXEL_FUNCTION_COUNTER();
-	VOXEL_USE_NAMESPACE(MetaGraph);
-
-	PrivateStart = Start;
-	PrivateStep = Step;
-	PrivateSize = Size;
+	VOXEL_SCOPE_LOCK(CriticalSection);
 
-	if (!ensure(PrivateSize % 2 == 0))
+	if (CachedPositions_RequiresLock)
 	{
-		PrivateSize = PrivateSize + 1;
+		return CachedPositions_RequiresLock.GetValue();
 	}
 
+	VOXEL_FUNCTION_COUNTER();
+	VOXEL_USE_NAMESPACE(MetaGraph);
+
 	TVoxelArray<float> WriteX = FVoxelFloatBuffer::Allocate(PrivateSize.X * PrivateSize.Y);
 	TVoxelArray<float> WriteY = FVoxelFloatBuffer::Allocate(PrivateSize.X * PrivateSize.Y);
 
@@ -183,11 +202,32 @@ void FVoxelDense2DPositionQueryData::Initialize(
 		PrivateStep,
 		PrivateSize);
 
-	CachedPositions.X = FVoxelFloatBuffer::MakeCpu(WriteX);
-	CachedPositions.Y = FVoxelFloatBuffer::MakeCpu(WriteY);
-	CachedPositions.Z = FVoxelFloatBuffer::Constant(0.f);
+	FVoxelVectorBuffer Positions;
+	Positions.X = FVoxelFloatBuffer::MakeCpu(WriteX);
+	Positions.Y = FVoxelFloatBuffer::MakeCpu(WriteY);
+	Positions.Z = FVoxelFloatBuffer::Constant(0.f);
+	Positions.SetBounds(GetBounds().ToBox3D(0.f, 0.f));
+
+	CachedPositions_RequiresLock = Positions;
+	return Positions;
+}
+
+void FVoxelDense2DPositionQueryData::Initialize(
+	const FVector2f& Start,
+	const float Step,
+	const FIntPoint& Size)
+{
+	PrivateStart = Start;
+	PrivateStep = Step;
+	PrivateSize = Size;
+
+	if (!ensure(PrivateSize % 2 == 0))
+	{
+		PrivateSize = PrivateSize + 1;
+	}
 
-	CachedPositions.SetBounds(GetBounds().ToBox3D(0.f, 0.f));
+	VOXEL_SCOPE_LOCK(CriticalSection);
+	CachedPositions_RequiresLock.Reset();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -288,8 +328,10 @@ void FVoxelNode_QueryWithPosition::PromotePin(FVoxelPin& Pin, const FVoxelPinTyp
 
 DEFINE_VOXEL_NODE(FVoxelNode_Query2D, OutData)
 {
+	// ExpandQuery2D is CPU only
 	const TSharedPtr<const FVoxelDensePositionQueryData> PositionQueryData = Query.Find<FVoxelDensePositionQueryData>();
-	if (!PositionQueryData ||
+	if (Query.IsGpu() ||
+		!PositionQueryData ||
 		PositionQueryData->GetSize().Z <= 1)
 	{
 		return Get(DataPin, Query);
@@ -302,12 +344,25 @@ DEFINE_VOXEL_NODE(FVoxelNode_Query2D, OutData)
 		FIntPoint(PositionQueryData->GetSize().X, PositionQueryData->GetSize().Y));
 	
 	const TValue<FVoxelBuffer> DataBuffer = Get<FVoxelBuffer>(DataPin, ChildQuery);
+
+	// Codegen graphs forward their intervals to uniform sign probes
+	// If they were lost here, chunks far from a 2D surface (eg Z - Height(XY)) would no longer be skipped
+	const bool bExpectInterval =
+		Query.Find<FVoxelUniformSignQueryData>() &&
+		INLINE_LAMBDA
+		{
+			const TSharedPtr<const FVoxelNodeRuntime::FPinData> OutputPinData = GetNodeRuntime().GetPinData(DataPin).OutputPinData;
+			return
+				OutputPinData &&
+				OutputPinData->ComputeState &&
+				OutputPinData->ComputeState->Node->IsA<FVoxelNode_ExecCodeGen>();
+		};
 	
-	return VOXEL_ON_COMPLETE(AnyThread, PositionQueryData, DataBuffer)
+	return VOXEL_ON_COMPLETE(AnyThread, PositionQueryData, DataBuffer, bExpectInterval)
 	{
 		const TValue<FVoxelBufferView> DataView = DataBuffer->MakeGenericView();
 
-		return VOXEL_ON_COMPLETE(AsyncThread, PositionQueryData, DataBuffer, DataView)
+		return VOXEL_ON_COMPLETE(AsyncThread, PositionQueryData, DataBuffer, DataView, bExpectInterval)
 		{
 			if (DataView->IsConstant())
 			{
@@ -318,6 +373,16 @@ DEFINE_VOXEL_NODE(FVoxelNode_Query2D, OutData)
 			Result.Get<FVoxelBuffer>().ForeachBufferPair(*DataBuffer, [&](FVoxelTerminalBuffer& ResultBuffer, const FVoxelTerminalBuffer& DataTerminalBuffer)
 			{
 				ResultBuffer = FVoxelBufferUtilities::ExpandQuery2D_Cpu(DataTerminalBuffer.MakeView().Get_CheckCompleted(), PositionQueryData->GetSize().Z);
+
+				// Same values, only repeated along Z
+				if (const TOptional<FFloatInterval> Interval = DataTerminalBuffer.GetInterval())
+				{
+					ResultBuffer.SetInterval(*Interval);
+				}
+				else
+				{
+					ensureVoxelSlow(!bExpectInterval || !DataTerminalBuffer.GetInnerType().Is<float>());
+				}
 			});
 			return FVoxelSharedPinValue(Result);
 		};
@@ -6,13 +6,15 @@ TVoxelFutureValue<FVoxelExecObject> FVoxelExecNode_SpawnChunksByRange::Execute(c
 {
 	const TValue<float> ChunkSize = GetNodeRuntime().Get(ChunkSizePin, Query);
 	const TValue<int32> RenderDistanceInChunks = GetNodeRuntime().Get(RenderDistanceInChunksPin, Query);
+	const TValue<bool> ScaleWithMemoryBudget = GetNodeRuntime().Get(ScaleWithMemoryBudgetPin, Query);
 
-	return VOXEL_ON_COMPLETE(AsyncThread, ChunkSize, RenderDistanceInChunks)
+	return VOXEL_ON_COMPLETE(AsyncThread, ChunkSize, RenderDistanceInChunks, ScaleWithMemoryBudget)
 	{
 		const TSharedRef<FVoxelExecObject_SpawnChunksByRange> Object = MakeShared<FVoxelExecObject_SpawnChunksByRange>();
 		Object->Initialize(*this);
 		Object->ChunkSize = ChunkSize;
 		Object->RenderDistanceInChunks = FMath::Clamp(RenderDistanceInChunks, 1, 128);
+		Object->bScaleWithMemoryBudget = ScaleWithMemoryBudget;
 		return Object;
 	};
 }
@@ -40,13 +42,16 @@ void FVoxelExecObject_SpawnChunksByRange::Tick(FVoxelRuntime& Runtime)
 	}
 	CameraPosition = Runtime.WorldToLocal().TransformPosition(CameraPosition);
 
+	const float DetailScale = bScaleWithMemoryBudget ? FVoxelChunkManager::GetDetailScale() : 1.f;
 	if (VisibleChunks.IsValid() &&
-		FVoxelUtilities::Abs(CameraPosition - LastCameraPosition).GetMax() < GVoxelChunkSpawnerCameraRefreshThreshold)
+		FVoxelUtilities::Abs(CameraPosition - LastCameraPosition).GetMax() < GVoxelChunkSpawnerCameraRefreshThreshold &&
+		FMath::Abs(DetailScale - LastDetailScale) < GVoxelChunkSpawnerDetailScaleRefreshThreshold)
 	{
 		return;
 	}
 
 	LastCameraPosition = CameraPosition;
+	LastDetailScale = DetailScale;
 	bUpdateInProgress = true;
 
 	Runtime.AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, MakeWeakPtrLambda(this, [=, &Runtime]
@@ -76,7 +81,9 @@ void FVoxelExecObject_SpawnChunksByRange::Tick(FVoxelRuntime& Runtime)
 		{
 			VOXEL_SCOPE_COUNTER("Find ChunksToAdd");
 
-			const uint64 RenderDistanceSquared = FMath::Square<uint64>(RenderDistanceInChunks);
+			// When over the memory budget, only spawn the closest chunks
+			const int32 RenderDistance = FMath::Clamp(FMath::CeilToInt(RenderDistanceInChunks * DetailScale), 1, RenderDistanceInChunks);
+			const uint64 RenderDistanceSquared = FMath::Square<uint64>(RenderDistance);
 			for (int32 Z = 0; Z < Size; Z++)
 			{
 				for (int32 Y = 0; Y < Size; Y++)
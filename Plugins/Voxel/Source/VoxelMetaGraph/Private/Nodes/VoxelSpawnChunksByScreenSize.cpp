@@ -54,20 +54,23 @@ void FVoxelExecObject_SpawnChunksByScreenSize::Tick(FVoxelRuntime& Runtime)
 	}
 
 	const FVector LocalViewOrigin = Runtime.WorldToLocal().TransformPosition(ViewOrigin);
-	if (FVector::Distance(LocalViewOrigin, LastLocalViewOrigin) < GVoxelChunkSpawnerCameraRefreshThreshold)
+	const float DetailScale = FVoxelChunkManager::GetDetailScale();
+	if (FVector::Distance(LocalViewOrigin, LastLocalViewOrigin) < GVoxelChunkSpawnerCameraRefreshThreshold &&
+		FMath::Abs(DetailScale - LastDetailScale) < GVoxelChunkSpawnerDetailScaleRefreshThreshold)
 	{
 		return;
 	}
 
 	LastLocalViewOrigin = LocalViewOrigin;
-	UpdateTree(Runtime, LocalViewOrigin);
+	LastDetailScale = DetailScale;
+	UpdateTree(Runtime, LocalViewOrigin, DetailScale);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-void FVoxelExecObject_SpawnChunksByScreenSize::UpdateTree(FVoxelRuntime& Runtime, const FVector& LocalViewOrigin)
+void FVoxelExecObject_SpawnChunksByScreenSize::UpdateTree(FVoxelRuntime& Runtime, const FVector& LocalViewOrigin, const float DetailScale)
 {
 	VOXEL_FUNCTION_COUNTER();
 	VOXEL_USE_NAMESPACE(SpawnChunksByScreenSize);
@@ -92,6 +95,7 @@ void FVoxelExecObject_SpawnChunksByScreenSize::UpdateTree(FVoxelRuntime& Runtime
 		const TSharedRef<FOctree> NewTree = MakeShared<FOctree>(
 			OctreeDepth,
 			LocalViewOrigin,
+			DetailScale,
 			*this);
 
 		if (OldTree)
@@ -320,7 +324,8 @@ void FOctree::Update(
 		// unwanted/unstable results on different screen ratio or when zooming
 		const double ScreenSize = ChunkBounds.Size().GetMax() / FMath::Max(1., Distance);
 
-		if (ScreenSize > Object.ChunkScreenSize && GetHeight(Node) > 0)
+		// When over the memory budget, subdivide less to use coarser chunks
+		if (ScreenSize > Object.ChunkScreenSize / DetailScale && GetHeight(Node) > 0)
 		{
 			if (!HasChildren(Node))
 			{
@@ -220,6 +220,39 @@ TSharedRef<FVoxelBufferData> FVoxelBufferUtilities::Filter_Cpu(const FVoxelTermi
 	return FVoxelBufferData::MakeCpu(Buffer.GetInnerType(), MakeSharedCopy(MoveTemp(OutData)));
 }
 
+bool FVoxelBufferUtilities::Scatter_Cpu(const TVoxelArrayView<uint8> Data, const FVoxelTerminalBufferView& Values, const TConstVoxelArrayView<int32> Indices)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (Values.Num() != 1 &&
+		Values.Num() != Indices.Num())
+	{
+		return false;
+	}
+
+	const int32 TypeSize = Values.GetInnerType().GetTypeSize();
+
+	const TConstVoxelArrayView<uint8> ValuesByteView = Values.MakeByteView();
+
+	VOXEL_SWITCH_TERMINAL_TYPE_SIZE(TypeSize)
+	{
+		for (int32 Index = 0; Index < Indices.Num(); Index++)
+		{
+			const int32 WriteIndex = Indices[Index];
+			if (WriteIndex < 0)
+			{
+				continue;
+			}
+			checkVoxelSlow((WriteIndex + 1) * StaticTypeSize <= Data.Num());
+
+			const uint8* Value = Values.Num() == 1 ? ValuesByteView.GetData() : &ValuesByteView[Index * StaticTypeSize];
+			FMemory::Memcpy(&Data[WriteIndex * StaticTypeSize], Value, StaticTypeSize);
+		}
+	};
+
+	return true;
+}
+
 TSharedRef<FVoxelBufferData> FVoxelBufferUtilities::Select_Cpu(TConstVoxelArrayView<int32> Indices, TConstVoxelArrayView<const FVoxelTerminalBufferView*> Buffers)
 {
 	VOXEL_FUNCTION_COUNTER();
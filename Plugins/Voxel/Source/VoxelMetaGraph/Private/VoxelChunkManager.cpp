@@ -13,7 +13,53 @@ VOXEL_CONSOLE_VARIABLE(
 	"voxel.chunkspawner.CameraRefreshThreshold",
 	"");
 
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, float, GVoxelChunkSpawnerDetailScaleRefreshThreshold, 0.05f,
+	"voxel.chunkspawner.DetailScaleRefreshThreshold",
+	"Chunk spawners are refreshed when the chunk manager detail scale changes by more than this");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, float, GVoxelChunkManagerGameThreadBudget, 2.f,
+	"voxel.chunkmanager.GameThreadBudget",
+	"Time in milliseconds spent creating & destroying chunk objects on the game thread every frame. At least one chunk is processed per frame");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, float, GVoxelChunkManagerMaxDestroyDelay, 5.f,
+	"voxel.chunkmanager.MaxDestroyDelay",
+	"Destroyed chunks are kept until the chunks overlapping them are created, to avoid holes. Max time in seconds to wait for them");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, float, GVoxelChunkManagerMemoryBudget, 0.f,
+	"voxel.chunkmanager.MemoryBudget",
+	"Memory in MB the objects of all the chunks can use, eg meshes, colliders, navmeshes and foliage. "
+	"When over budget, chunk spawners reduce their view distance. 0 to disable");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, float, GVoxelChunkManagerMinDetailScale, 0.25f,
+	"voxel.chunkmanager.MinDetailScale",
+	"Min scale applied to the chunk spawners view distance when over the memory budget");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, float, GVoxelChunkManagerDetailScaleSpeed, 0.2f,
+	"voxel.chunkmanager.DetailScaleSpeed",
+	"How fast the detail scale changes when over or under the memory budget, relative change per second");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, float, GVoxelChunkManagerEvictionThreshold, 1.25f,
+	"voxel.chunkmanager.EvictionThreshold",
+	"When the chunk objects memory goes above MemoryBudget times this, the objects of the chunks furthest away are destroyed "
+	"until back under budget. Gameplay relevant chunks are never evicted");
+
 DEFINE_UNIQUE_VOXEL_ID(FVoxelChunkId);
+DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelChunkObjectsMemory);
+
+// Detail scale is only increased back once memory is below MemoryBudget times this, to avoid oscillating
+constexpr double GVoxelChunkManagerMemoryHysteresis = 0.9;
+
+static int64 GVoxelChunkManagerAllocatedSize = 0;
+static float GVoxelChunkManagerDetailScale = 1.f;
+static uint64 GVoxelChunkManagerDetailScaleFrame = MAX_uint64;
+static double GVoxelChunkManagerDetailScaleTime = 0.;
 
 void FVoxelPendingChunksCounter::Decrement()
 {
@@ -66,8 +112,11 @@ void FVoxelChunkManager::Destroy(FVoxelRuntime& Runtime)
 	}
 
 	ProcessActions(Runtime);
+	ProcessPendingWork(Runtime, true);
 
 	ensure(ChunkInfos.Num() == 0);
+	ensure(PendingTaskCompletions_GameThread.Num() == 0);
+	ensure(PendingDestroys_GameThread.Num() == 0);
 }
 
 void FVoxelChunkManager::Tick(FVoxelRuntime& Runtime)
@@ -103,74 +152,410 @@ void FVoxelChunkManager::Tick(FVoxelRuntime& Runtime)
 	}
 
 	{
-		VOXEL_SCOPE_COUNTER("Process GameThreadTasks");
+		VOXEL_SCOPE_COUNTER("Dequeue TaskCompletions");
+		VOXEL_SCOPE_LOCK(CriticalSection);
+
+		FTaskCompletion TaskCompletion;
+		while (TaskCompletionQueue.Dequeue(TaskCompletion))
+		{
+			const TSharedPtr<FChunkInfo> ChunkInfo = TaskCompletion.ChunkInfo;
+			if (!ChunkInfos.Contains(ChunkInfo->ChunkId))
+			{
+				continue;
+			}
+			if (ChunkInfo->Task_GameThread.Get() != TaskCompletion.TaskPtr)
+			{
+				continue;
+			}
+			checkVoxelSlow(ChunkInfos[ChunkInfo->ChunkId] == ChunkInfo);
+
+			PendingTaskCompletions_GameThread.Add({ MoveTemp(TaskCompletion), ChunkInfo });
+		}
+	}
+
+	ProcessPendingWork(Runtime, false);
+
+	UpdateDetailScale();
+	UpdateEvictedChunks(Runtime);
+
+	// Process tasks queued by OnComplete
+	ProcessActions(Runtime);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelChunkManager::ProcessPendingWork(FVoxelRuntime& Runtime, const bool bFlush)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+	const auto IsOutOfBudget = [&]
+	{
+		return
+			!bFlush &&
+			(FPlatformTime::Seconds() - StartTime) * 1000. > GVoxelChunkManagerGameThreadBudget;
+	};
+
+	// Completions of tasks cancelled since they were queued
+	PendingTaskCompletions_GameThread.RemoveAllSwap([](const TPair<FTaskCompletion, TSharedPtr<FChunkInfo>>& It)
+	{
+		return It.Value->Task_GameThread.Get() != It.Key.TaskPtr;
+	});
+
+	if (!bFlush &&
+		PendingTaskCompletions_GameThread.Num() > 1)
+	{
+		VOXEL_SCOPE_COUNTER("Sort");
 
-		TVoxelArray<TPair<FTaskCompletion, TSharedPtr<FChunkInfo>>> TaskCompletions;
+		const FVector3d PriorityPosition = Runtime.GetPriorityPosition();
+
+		TVoxelArray<double> Distances;
+		TVoxelArray<bool> IsGameplayRelevant;
+		FVoxelUtilities::SetNumFast(Distances, PendingTaskCompletions_GameThread.Num());
+		FVoxelUtilities::SetNumFast(IsGameplayRelevant, PendingTaskCompletions_GameThread.Num());
+
+		for (int32 Index = 0; Index < PendingTaskCompletions_GameThread.Num(); Index++)
 		{
-			VOXEL_SCOPE_LOCK(CriticalSection);
+			const TPair<FTaskCompletion, TSharedPtr<FChunkInfo>>& It = PendingTaskCompletions_GameThread[Index];
 
-			FTaskCompletion TaskCompletion;
-			while (TaskCompletionQueue.Dequeue(TaskCompletion))
+			Distances[Index] = It.Value->Bounds.ComputeSquaredDistanceFromBoxToPoint(PriorityPosition);
+			IsGameplayRelevant[Index] = It.Key.ChunkObjects.ContainsByPredicate([](const TSharedPtr<const FVoxelChunkExecObject>& ChunkObject)
 			{
-				const TSharedPtr<FChunkInfo> ChunkInfo = TaskCompletion.ChunkInfo;
-				if (!ChunkInfos.Contains(ChunkInfo->ChunkId))
-				{
-					continue;
-				}
-				if (ChunkInfo->Task_GameThread.Get() != TaskCompletion.TaskPtr)
-				{
-					continue;
-				}
-				checkVoxelSlow(ChunkInfos[ChunkInfo->ChunkId] == ChunkInfo);
+				return ChunkObject->IsGameplayRelevant();
+			});
+		}
 
-				TaskCompletions.Add({ MoveTemp(TaskCompletion), ChunkInfo });
+		TVoxelArray<int32> SortedIndices;
+		FVoxelUtilities::SetNumFast(SortedIndices, Distances.Num());
+		for (int32 Index = 0; Index < SortedIndices.Num(); Index++)
+		{
+			SortedIndices[Index] = Index;
+		}
+		SortedIndices.Sort([&](const int32 A, const int32 B)
+		{
+			// Gameplay relevant chunks first, then closest first
+			if (IsGameplayRelevant[A] != IsGameplayRelevant[B])
+			{
+				return IsGameplayRelevant[A];
 			}
+			return Distances[A] < Distances[B];
+		});
+
+		TVoxelArray<TPair<FTaskCompletion, TSharedPtr<FChunkInfo>>> SortedTaskCompletions;
+		SortedTaskCompletions.Reserve(SortedIndices.Num());
+		for (const int32 Index : SortedIndices)
+		{
+			SortedTaskCompletions.Add(MoveTemp(PendingTaskCompletions_GameThread[Index]));
 		}
+		PendingTaskCompletions_GameThread = MoveTemp(SortedTaskCompletions);
+	}
 
-		for (auto& It : TaskCompletions)
+	bool bIsOutOfBudget = false;
+	{
+		VOXEL_SCOPE_COUNTER("Apply TaskCompletions");
+
+		int32 NumProcessed = 0;
+		while (
+			NumProcessed < PendingTaskCompletions_GameThread.Num() &&
+			!bIsOutOfBudget)
 		{
-			FTaskCompletion TaskCompletion = MoveTemp(It.Key);
-			const TSharedPtr<FChunkInfo> ChunkInfo = It.Value;
+			TPair<FTaskCompletion, TSharedPtr<FChunkInfo>>& It = PendingTaskCompletions_GameThread[NumProcessed++];
+			ApplyTaskCompletion(Runtime, It.Key, *It.Value);
 
-			ChunkInfo->Task_GameThread.Reset();
-			
-			for (const TSharedPtr<const FVoxelChunkExecObject>& ChunkObject : ChunkInfo->ChunkObjects_GameThread)
+			bIsOutOfBudget = IsOutOfBudget();
+		}
+		PendingTaskCompletions_GameThread.RemoveAt(0, NumProcessed, false);
+	}
+
+	if (PendingDestroys_GameThread.Num() == 0)
+	{
+		return;
+	}
+
+	VOXEL_SCOPE_COUNTER("Process PendingDestroys");
+
+	// Destroying a chunk before the chunks replacing it are created would leave a hole
+	TVoxelArray<FVoxelBox> BoundsBeingCreated;
+	if (!bFlush)
+	{
+		VOXEL_SCOPE_LOCK(CriticalSection);
+
+		for (const auto& It : ChunkInfos)
+		{
+			if (!It.Value->bHasCompleted_GameThread)
 			{
-				ChunkObject->CallDestroy(Runtime);
+				BoundsBeingCreated.Add(It.Value->Bounds);
 			}
+		}
+	}
 
-			ChunkInfo->ChunkObjects_GameThread = MoveTemp(TaskCompletion.ChunkObjects);
+	const double Time = FPlatformTime::Seconds();
 
-			for (const TSharedPtr<const FVoxelChunkExecObject>& ChunkObject : ChunkInfo->ChunkObjects_GameThread)
+	TVoxelArray<FPendingDestroy> PendingDestroys = MoveTemp(PendingDestroys_GameThread);
+	for (FPendingDestroy& PendingDestroy : PendingDestroys)
+	{
+		if (bIsOutOfBudget)
+		{
+			PendingDestroys_GameThread.Add(MoveTemp(PendingDestroy));
+			continue;
+		}
+
+		if (PendingDestroy.Time + GVoxelChunkManagerMaxDestroyDelay > Time &&
+			BoundsBeingCreated.ContainsByPredicate([&](const FVoxelBox& Bounds)
 			{
-				ChunkObject->CallCreate(Runtime);
+				return Bounds.Intersect(PendingDestroy.ChunkInfo->Bounds);
+			}))
+		{
+			PendingDestroys_GameThread.Add(MoveTemp(PendingDestroy));
+			continue;
+		}
+
+		DestroyChunkObjects(Runtime, *PendingDestroy.ChunkInfo);
+
+		bIsOutOfBudget = IsOutOfBudget();
+	}
+}
+
+void FVoxelChunkManager::ApplyTaskCompletion(FVoxelRuntime& Runtime, FTaskCompletion& TaskCompletion, FChunkInfo& ChunkInfo)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (!ensure(ChunkInfo.Task_GameThread.Get() == TaskCompletion.TaskPtr))
+	{
+		return;
+	}
+
+	ChunkInfo.Task_GameThread.Reset();
+	ChunkInfo.bHasCompleted_GameThread = true;
+
+	DestroyChunkObjects(Runtime, ChunkInfo);
+
+	ChunkInfo.ChunkObjects_GameThread = MoveTemp(TaskCompletion.ChunkObjects);
+
+	for (const TSharedPtr<const FVoxelChunkExecObject>& ChunkObject : ChunkInfo.ChunkObjects_GameThread)
+	{
+		ChunkObject->CallCreate(Runtime);
+	}
+
+	ensure(ChunkInfo.AllocatedSize_GameThread == 0);
+	for (const TSharedPtr<const FVoxelChunkExecObject>& ChunkObject : ChunkInfo.ChunkObjects_GameThread)
+	{
+		ChunkInfo.AllocatedSize_GameThread += ChunkObject->GetAllocatedSize();
+	}
+	GVoxelChunkManagerAllocatedSize += ChunkInfo.AllocatedSize_GameThread;
+	INC_VOXEL_MEMORY_STAT_BY(STAT_VoxelChunkObjectsMemory, ChunkInfo.AllocatedSize_GameThread);
+
+	if (ChunkInfo.bIsEvicted_GameThread)
+	{
+		ChunkInfo.bIsEvicted_GameThread = false;
+		NumEvictedChunks_GameThread--;
+		ensure(NumEvictedChunks_GameThread >= 0);
+	}
+	ChunkInfo.EvictedSize_GameThread = 0;
+
+	ChunkInfo.Dependencies_GameThread = MoveTemp(TaskCompletion.Dependencies);
+
+	{
+		FVoxelScopeLock Lock(FVoxelDependency::CriticalSection);
+		for (const TSharedPtr<FVoxelDependency>& Dependency : ChunkInfo.Dependencies_GameThread)
+		{
+			Dependency->Chunks_RequiresLock.FindOrAdd(AsShared()).Add(ChunkInfo.ChunkId);
+
+			if (Dependency->IsInvalidated() &&
+				!ChunkInfo.UpdateQueued)
+			{
+				ActionQueue->Enqueue(FVoxelChunkAction(EVoxelChunkAction::Update, ChunkInfo.ChunkId));
+				ChunkInfo.UpdateQueued = true;
+			}
+		}
+	}
+
+	ChunkInfo.PendingChunks_GameThread.Reset();
+
+	ChunkInfo.FlushOnComplete();
+}
+
+void FVoxelChunkManager::DestroyChunkObjects(FVoxelRuntime& Runtime, FChunkInfo& ChunkInfo)
+{
+	for (const TSharedPtr<const FVoxelChunkExecObject>& ChunkObject : ChunkInfo.ChunkObjects_GameThread)
+	{
+		ChunkObject->CallDestroy(Runtime);
+	}
+	ChunkInfo.ChunkObjects_GameThread.Reset();
+
+	GVoxelChunkManagerAllocatedSize -= ChunkInfo.AllocatedSize_GameThread;
+	DEC_VOXEL_MEMORY_STAT_BY(STAT_VoxelChunkObjectsMemory, ChunkInfo.AllocatedSize_GameThread);
+	ChunkInfo.AllocatedSize_GameThread = 0;
+	ensure(GVoxelChunkManagerAllocatedSize >= 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int64 FVoxelChunkManager::GetAllocatedSize()
+{
+	check(IsInGameThread());
+	return GVoxelChunkManagerAllocatedSize;
+}
+
+float FVoxelChunkManager::GetDetailScale()
+{
+	check(IsInGameThread());
+	return GVoxelChunkManagerDetailScale;
+}
+
+void FVoxelChunkManager::UpdateDetailScale()
+{
+	check(IsInGameThread());
+
+	// Shared by all the chunk managers, only update it once per frame
+	if (GVoxelChunkManagerDetailScaleFrame == GFrameCounter)
+	{
+		return;
+	}
+	GVoxelChunkManagerDetailScaleFrame = GFrameCounter;
+
+	const double Time = FPlatformTime::Seconds();
+	const double DeltaTime = FMath::Clamp(Time - GVoxelChunkManagerDetailScaleTime, 0., 1.);
+	GVoxelChunkManagerDetailScaleTime = Time;
+
+	const double MemoryBudget = GVoxelChunkManagerMemoryBudget * 1024. * 1024.;
+	if (MemoryBudget <= 0.)
+	{
+		GVoxelChunkManagerDetailScale = 1.f;
+		return;
+	}
+
+	const float MinDetailScale = FMath::Clamp(GVoxelChunkManagerMinDetailScale, 0.01f, 1.f);
+	const float Factor = FMath::Pow(1.f + FMath::Max(GVoxelChunkManagerDetailScaleSpeed, 0.f), float(DeltaTime));
+
+	if (GVoxelChunkManagerAllocatedSize > MemoryBudget)
+	{
+		GVoxelChunkManagerDetailScale = FMath::Max(GVoxelChunkManagerDetailScale / Factor, MinDetailScale);
+	}
+	else if (GVoxelChunkManagerAllocatedSize < MemoryBudget * GVoxelChunkManagerMemoryHysteresis)
+	{
+		GVoxelChunkManagerDetailScale = FMath::Min(GVoxelChunkManagerDetailScale * Factor, 1.f);
+	}
+}
+
+void FVoxelChunkManager::UpdateEvictedChunks(FVoxelRuntime& Runtime)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	const double MemoryBudget = GVoxelChunkManagerMemoryBudget * 1024. * 1024.;
+
+	if (MemoryBudget <= 0. ||
+		GVoxelChunkManagerAllocatedSize < MemoryBudget * GVoxelChunkManagerMemoryHysteresis)
+	{
+		if (NumEvictedChunks_GameThread == 0)
+		{
+			return;
+		}
+
+		// Back under budget: recreate the evicted chunks closest first, as long as they fit in the budget
+		const FVector3d PriorityPosition = Runtime.GetPriorityPosition();
+
+		VOXEL_SCOPE_LOCK(CriticalSection);
+
+		// Recreations still in flight will add their size back once complete
+		int64 ExpectedSize = GVoxelChunkManagerAllocatedSize;
+
+		using FCandidate = TPair<double, TSharedPtr<FChunkInfo>>;
+		TVoxelArray<FCandidate> Candidates;
+		for (const auto& It : ChunkInfos)
+		{
+			const FChunkInfo& ChunkInfo = *It.Value;
+			if (!ChunkInfo.bIsEvicted_GameThread)
+			{
+				ExpectedSize += ChunkInfo.EvictedSize_GameThread;
+				continue;
 			}
 
-			ChunkInfo->Dependencies_GameThread = MoveTemp(TaskCompletion.Dependencies);
+			Candidates.Add({ ChunkInfo.Bounds.ComputeSquaredDistanceFromBoxToPoint(PriorityPosition), It.Value });
+		}
+
+		// Closest first
+		Candidates.Sort([](const FCandidate& A, const FCandidate& B)
+		{
+			return A.Key < B.Key;
+		});
 
+		for (const FCandidate& Candidate : Candidates)
+		{
+			FChunkInfo& ChunkInfo = *Candidate.Value;
+			if (MemoryBudget > 0. &&
+				ExpectedSize + ChunkInfo.EvictedSize_GameThread > MemoryBudget)
 			{
-				FVoxelScopeLock Lock(FVoxelDependency::CriticalSection);
-				for (const TSharedPtr<FVoxelDependency>& Dependency : ChunkInfo->Dependencies_GameThread)
-				{
-					Dependency->Chunks_RequiresLock.FindOrAdd(AsShared()).Add(ChunkInfo->ChunkId);
-
-					if (Dependency->IsInvalidated() &&
-						!ChunkInfo->UpdateQueued)
-					{
-						ActionQueue->Enqueue(FVoxelChunkAction(EVoxelChunkAction::Update, ChunkInfo->ChunkId));
-						ChunkInfo->UpdateQueued = true;
-					}
-				}
+				break;
 			}
+			ExpectedSize += ChunkInfo.EvictedSize_GameThread;
 
-			ChunkInfo->PendingChunks_GameThread.Reset();
+			ChunkInfo.bIsEvicted_GameThread = false;
+			NumEvictedChunks_GameThread--;
 
-			ChunkInfo->FlushOnComplete();
+			if (!ChunkInfo.UpdateQueued)
+			{
+				ActionQueue->Enqueue(FVoxelChunkAction(EVoxelChunkAction::Update, ChunkInfo.ChunkId));
+				ChunkInfo.UpdateQueued = true;
+			}
 		}
+		ensure(NumEvictedChunks_GameThread >= 0);
+		return;
 	}
 
-	// Process tasks queued by OnComplete
-	ProcessActions(Runtime);
+	if (GVoxelChunkManagerAllocatedSize <= MemoryBudget * FMath::Max(GVoxelChunkManagerEvictionThreshold, 1.f))
+	{
+		// The spawners are catching up through the detail scale
+		return;
+	}
+
+	const FVector3d PriorityPosition = Runtime.GetPriorityPosition();
+
+	using FCandidate = TPair<double, TSharedPtr<FChunkInfo>>;
+	TVoxelArray<FCandidate> Candidates;
+	{
+		VOXEL_SCOPE_LOCK(CriticalSection);
+
+		for (const auto& It : ChunkInfos)
+		{
+			const FChunkInfo& ChunkInfo = *It.Value;
+			if (ChunkInfo.AllocatedSize_GameThread == 0 ||
+				ChunkInfo.Task_GameThread ||
+				ChunkInfo.ChunkObjects_GameThread.ContainsByPredicate([](const TSharedPtr<const FVoxelChunkExecObject>& ChunkObject)
+				{
+					return ChunkObject->IsGameplayRelevant();
+				}))
+			{
+				continue;
+			}
+
+			Candidates.Add({ ChunkInfo.Bounds.ComputeSquaredDistanceFromBoxToPoint(PriorityPosition), It.Value });
+		}
+	}
+
+	// Furthest first
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	for (const FCandidate& Candidate : Candidates)
+	{
+		if (GVoxelChunkManagerAllocatedSize <= MemoryBudget)
+		{
+			break;
+		}
+
+		Candidate.Value->EvictedSize_GameThread = Candidate.Value->AllocatedSize_GameThread;
+		DestroyChunkObjects(Runtime, *Candidate.Value);
+		Candidate.Value->bIsEvicted_GameThread = true;
+		NumEvictedChunks_GameThread++;
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -412,13 +797,20 @@ void FVoxelChunkManager::ProcessAction(
 
 		OutChunksToFlush.Add(ChunkInfo);
 
+		if (ChunkInfo->bIsEvicted_GameThread)
+		{
+			ChunkInfo->bIsEvicted_GameThread = false;
+			NumEvictedChunks_GameThread--;
+			ensure(NumEvictedChunks_GameThread >= 0);
+		}
+
 		ChunkInfos.Remove(Action.ChunkId);
 
-		for (const TSharedPtr<const FVoxelChunkExecObject>& ChunkObject : ChunkInfo->ChunkObjects_GameThread)
+		if (ChunkInfo->ChunkObjects_GameThread.Num() > 0)
 		{
-			ChunkObject->CallDestroy(Runtime);
+			// Destroyed in ProcessPendingWork, once the chunks replacing it are created
+			PendingDestroys_GameThread.Add({ ChunkInfo, FPlatformTime::Seconds() });
 		}
-		ChunkInfo->ChunkObjects_GameThread.Reset();
 	}
 	break;
 	}
@@ -5,7 +5,9 @@
 #include "VoxelGraphMessages.h"
 #include "VoxelExposedPinType.h"
 #include "Nodes/VoxelExecCodeGenNode.h"
+#include "Nodes/VoxelPositionNodes.h"
 #include "Nodes/Templates/VoxelTemplateNode.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 
 BEGIN_VOXEL_NAMESPACE(MetaGraph)
 
@@ -14,6 +16,49 @@ VOXEL_CONSOLE_VARIABLE(
 	"voxel.metagraph.EnableDebugGraph",
 	"");
 
+VOXEL_CONSOLE_VARIABLE(
+	VOXELMETAGRAPH_API, int32, GVoxelMetaGraphCompileCacheSize, 64,
+	"voxel.metagraph.CompileCacheSize",
+	"Number of compiled graphs kept to be reused by new runtimes. 0 to disable");
+
+struct FVoxelMetaGraphCompileCacheEntry
+{
+	// Never modified, runtimes use a clone
+	TSharedPtr<const FGraph> Graph;
+	// Graphs & assets the key was computed from
+	// The entry is stale once any of them is unloaded, as a new asset could be loaded with the same path
+	TArray<TWeakObjectPtr<const UObject>> Objects;
+	uint64 LastUsed = 0;
+};
+
+uint64 GVoxelMetaGraphCompileCacheTime = 0;
+TMap<uint64, FVoxelMetaGraphCompileCacheEntry> GVoxelMetaGraphCompileCache;
+
+VOXEL_RUN_ON_STARTUP_GAME(RegisterMetaGraphCompileCacheCleanup)
+{
+	FWorldDelegates::OnWorldCleanup.AddLambda([](UWorld*, bool, bool)
+	{
+		GVoxelMetaGraphCompileCache.Empty();
+	});
+
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([]
+	{
+		VOXEL_SCOPE_COUNTER("Purge compile cache");
+
+		for (auto It = GVoxelMetaGraphCompileCache.CreateIterator(); It; ++It)
+		{
+			for (const TWeakObjectPtr<const UObject>& Object : It.Value().Objects)
+			{
+				if (!Object.IsValid())
+				{
+					It.RemoveCurrent();
+					break;
+				}
+			}
+		}
+	});
+}
+
 TSharedPtr<FGraph> FCompilerUtilities::Compile(
 	const UVoxelMetaGraph& MetaGraph,
 	FVoxelMetaGraphVariableCollection Variables,
@@ -27,6 +72,27 @@ TSharedPtr<FGraph> FCompilerUtilities::Compile(
 		return nullptr;
 	}
 
+	// In editor assets can change without the graph changing, so always recompile
+	uint64 CacheKey = 0;
+	TArray<TWeakObjectPtr<const UObject>> CacheObjects;
+	const bool bUseCache =
+		!GIsEditor &&
+		Runtime &&
+		!GEnableDebugGraph &&
+		GVoxelMetaGraphCompileCacheSize > 0 &&
+		GetCompileCacheKey(MetaGraph, Variables, CacheKey, CacheObjects);
+
+	if (bUseCache)
+	{
+		check(IsInGameThread());
+
+		if (FVoxelMetaGraphCompileCacheEntry* Entry = GVoxelMetaGraphCompileCache.Find(CacheKey))
+		{
+			Entry->LastUsed = ++GVoxelMetaGraphCompileCacheTime;
+			return Entry->Graph->Clone();
+		}
+	}
+
 	const FVoxelGraphMessages Messages(MetaGraph.GetMainGraph());
 
 	Variables.Fixup(MetaGraph.Parameters);
@@ -92,10 +158,36 @@ TSharedPtr<FGraph> FCompilerUtilities::Compile(
 
 	RUN_PASS(CheckOutputs);
 	RUN_PASS(ReplaceParameters, Variables, Runtime);
+	RUN_PASS(MergeIdenticalNodes);
+	RUN_PASS(InsertQuery2DNodes);
 	RUN_PASS(ReplaceCodeGenNodes);
 
 #undef RUN_PASS
 
+	if (bUseCache)
+	{
+		// Evict the least recently used graphs
+		while (GVoxelMetaGraphCompileCache.Num() >= GVoxelMetaGraphCompileCacheSize)
+		{
+			uint64 OldestKey = 0;
+			uint64 OldestLastUsed = MAX_uint64;
+			for (const auto& It : GVoxelMetaGraphCompileCache)
+			{
+				if (It.Value.LastUsed < OldestLastUsed)
+				{
+					OldestKey = It.Key;
+					OldestLastUsed = It.Value.LastUsed;
+				}
+			}
+			GVoxelMetaGraphCompileCache.Remove(OldestKey);
+		}
+
+		FVoxelMetaGraphCompileCacheEntry& Entry = GVoxelMetaGraphCompileCache.Add(CacheKey);
+		Entry.Graph = Graph;
+		Entry.Objects = MoveTemp(CacheObjects);
+		Entry.LastUsed = ++GVoxelMetaGraphCompileCacheTime;
+	}
+
 	return Graph->Clone();
 }
 
@@ -756,6 +848,251 @@ void FCompilerUtilities::ReplaceParameters(FGraph& Graph, const FVoxelMetaGraphV
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+void FCompilerUtilities::MergeIdenticalNodes(FGraph& Graph)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	const auto CanMerge = [](const FNode& Node)
+	{
+		if (Node.Type != ENodeType::Struct ||
+			Node.Struct()->HasSideEffects())
+		{
+			return false;
+		}
+
+		for (const FPin& Pin : Node.GetPins())
+		{
+			if (Pin.Type.IsDerivedFrom<FVoxelExecBase>())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	const auto AreIdentical = [](const FNode& A, const FNode& B)
+	{
+		if (A.Struct().GetScriptStruct() != B.Struct().GetScriptStruct() ||
+			A.GetInputPins().Num() != B.GetInputPins().Num() ||
+			A.GetOutputPins().Num() != B.GetOutputPins().Num())
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < A.GetOutputPins().Num(); Index++)
+		{
+			const FPin& PinA = A.GetOutputPin(Index);
+			const FPin& PinB = B.GetOutputPin(Index);
+
+			if (PinA.Name != PinB.Name ||
+				PinA.Type != PinB.Type)
+			{
+				return false;
+			}
+		}
+
+		// Predecessors are merged first, so identical inputs are linked to the same pin
+		for (int32 Index = 0; Index < A.GetInputPins().Num(); Index++)
+		{
+			const FPin& PinA = A.GetInputPin(Index);
+			const FPin& PinB = B.GetInputPin(Index);
+
+			if (PinA.Name != PinB.Name ||
+				PinA.Type != PinB.Type ||
+				PinA.GetLinkedTo().Num() != PinB.GetLinkedTo().Num())
+			{
+				return false;
+			}
+
+			if (PinA.GetLinkedTo().Num() > 0)
+			{
+				check(PinA.GetLinkedTo().Num() == 1);
+				if (&PinA.GetLinkedTo()[0] != &PinB.GetLinkedTo()[0])
+				{
+					return false;
+				}
+			}
+			else if (!(PinA.GetDefaultValue() == PinB.GetDefaultValue()))
+			{
+				return false;
+			}
+		}
+
+		return A.Struct().GetScriptStruct()->CompareScriptStruct(&A.Struct().Get(), &B.Struct().Get(), PPF_None);
+	};
+
+	TMap<const UScriptStruct*, TArray<FNode*>> StructToNodes;
+
+	int32 NumRemovedNodes = 0;
+	for (FNode* Node : SortNodes(Graph.GetNodesArray()))
+	{
+		if (!CanMerge(*Node))
+		{
+			continue;
+		}
+
+		TArray<FNode*>& Candidates = StructToNodes.FindOrAdd(Node->Struct().GetScriptStruct());
+
+		FNode* const* ExistingNode = Candidates.FindByPredicate([&](const FNode* Candidate)
+		{
+			return AreIdentical(*Candidate, *Node);
+		});
+		if (!ExistingNode)
+		{
+			Candidates.Add(Node);
+			continue;
+		}
+
+		for (int32 Index = 0; Index < Node->GetOutputPins().Num(); Index++)
+		{
+			FPin& OutputPin = Node->GetOutputPin(Index);
+			FPin& NewOutputPin = (**ExistingNode).GetOutputPin(Index);
+
+			const TArray<FPin*> LinkedTo = OutputPin.GetLinkedTo().Array();
+			OutputPin.BreakAllLinks();
+
+			for (FPin* InputPin : LinkedTo)
+			{
+				NewOutputPin.MakeLinkTo(*InputPin);
+			}
+		}
+
+		Graph.RemoveNode(*Node);
+		NumRemovedNodes++;
+	}
+
+	if (NumRemovedNodes > 0)
+	{
+		LOG_VOXEL(Log, "MergeIdenticalNodes: %d nodes removed", NumRemovedNodes);
+	}
+}
+
+void FCompilerUtilities::InsertQuery2DNodes(FGraph& Graph)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	// Nodes whose outputs only vary with XY
+	TSet<const FNode*> Nodes2D;
+	for (const FNode* Node : SortNodes(Graph.GetNodesArray()))
+	{
+		if (Node->Type != ENodeType::Struct)
+		{
+			continue;
+		}
+
+		const FVoxelNode& Struct = *Node->Struct();
+		if (Struct.IsA<FVoxelNode_GetPosition2D>())
+		{
+			Nodes2D.Add(Node);
+			continue;
+		}
+
+		if (!Struct.OnlyDependsOnInputs() ||
+			Struct.HasSideEffects())
+		{
+			continue;
+		}
+
+		bool bIs2D = false;
+		for (const FPin& InputPin : Node->GetInputPins())
+		{
+			// Uniforms are the same for the whole query, eg landmass brushes or curves
+			if (InputPin.GetLinkedTo().Num() == 0 ||
+				!InputPin.Type.IsBuffer())
+			{
+				continue;
+			}
+
+			if (!Nodes2D.Contains(&InputPin.GetLinkedTo()[0].Node))
+			{
+				bIs2D = false;
+				break;
+			}
+			bIs2D = true;
+		}
+
+		if (bIs2D)
+		{
+			Nodes2D.Add(Node);
+		}
+	}
+
+	int32 NumQuery2DNodes = 0;
+	for (const FNode* Node : Nodes2D)
+	{
+		// No need to query positions in 2D
+		if (Node->Struct()->IsA<FVoxelNode_GetPosition2D>())
+		{
+			continue;
+		}
+
+		for (FPin& OutputPin : VOXEL_CONST_CAST(*Node).GetOutputPins())
+		{
+			if (!OutputPin.Type.IsBuffer())
+			{
+				continue;
+			}
+
+			TArray<FPin*> PinsToRedirect;
+			for (FPin& LinkedTo : OutputPin.GetLinkedTo())
+			{
+				if (!Nodes2D.Contains(&LinkedTo.Node) &&
+					!(LinkedTo.Node.Type == ENodeType::Struct && LinkedTo.Node.Struct()->IsA<FVoxelNode_Query2D>()))
+				{
+					PinsToRedirect.Add(&LinkedTo);
+				}
+			}
+
+			if (PinsToRedirect.Num() == 0)
+			{
+				continue;
+			}
+
+			FNode& Query2DNode = Graph.NewNode(ENodeType::Struct, Node->Source);
+			Query2DNode.Struct() = FVoxelInstancedStruct::Make<FVoxelNode_Query2D>();
+
+			FVoxelNode& Query2D = *Query2DNode.Struct();
+			for (FVoxelPin& Pin : Query2D.GetPins())
+			{
+				if (Pin.bIsInput)
+				{
+					Query2D.PromotePin(Pin, OutputPin.Type);
+					break;
+				}
+			}
+
+			for (const FVoxelPin& Pin : Query2D.GetPins())
+			{
+				if (Pin.bIsInput)
+				{
+					OutputPin.MakeLinkTo(Query2DNode.NewInputPin(Pin.Name, Pin.GetType()));
+				}
+				else
+				{
+					FPin& NewOutputPin = Query2DNode.NewOutputPin(Pin.Name, Pin.GetType());
+					for (FPin* InputPin : PinsToRedirect)
+					{
+						OutputPin.BreakLinkTo(*InputPin);
+						NewOutputPin.MakeLinkTo(*InputPin);
+					}
+				}
+			}
+
+			NumQuery2DNodes++;
+		}
+	}
+
+	if (NumQuery2DNodes > 0)
+	{
+		LOG_VOXEL(Verbose, "InsertQuery2DNodes: %d 2D subgraphs found", NumQuery2DNodes);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 void FCompilerUtilities::ReplaceCodeGenNodes(FGraph& Graph)
 {
 	VOXEL_FUNCTION_COUNTER();
@@ -1066,6 +1403,117 @@ TSharedRef<FGraph> FCompilerUtilities::MakeSubGraph(
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+bool FCompilerUtilities::GetCompileCacheKey(
+	const UVoxelMetaGraph& MetaGraph,
+	const FVoxelMetaGraphVariableCollection& Variables,
+	uint64& OutKey,
+	TArray<TWeakObjectPtr<const UObject>>& OutObjects)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	const auto DependsOnRuntime = [](const FVoxelPinType& Type)
+	{
+		const FVoxelPinType InnerType = Type.IsBuffer() ? Type.GetInnerType() : Type;
+		const TVoxelInstancedStruct<FVoxelExposedPinType>& ExposedTypeInfo = InnerType.GetExposedTypeInfo();
+		return ExposedTypeInfo && ExposedTypeInfo->DependsOnRuntime();
+	};
+
+	TArray<const UVoxelMetaGraph*> Graphs;
+	{
+		TSet<const UVoxelMetaGraph*> VisitedGraphs;
+		TArray<const UVoxelMetaGraph*> GraphsToVisit;
+		GraphsToVisit.Add(&MetaGraph);
+
+		while (GraphsToVisit.Num() > 0)
+		{
+			const UVoxelMetaGraph* Graph = GraphsToVisit.Pop(false);
+			if (VisitedGraphs.Contains(Graph))
+			{
+				continue;
+			}
+			VisitedGraphs.Add(Graph);
+			Graphs.Add(Graph);
+
+			for (const FVoxelMetaGraphCompiledNode& Node : Graph->CompiledGraph.Nodes)
+			{
+				if (Node.Type == EVoxelMetaGraphCompiledNodeType::Macro &&
+					Node.MetaGraph)
+				{
+					GraphsToVisit.Add(Node.MetaGraph);
+				}
+
+				for (const FVoxelMetaGraphCompiledPin& Pin : Node.InputPins)
+				{
+					if (DependsOnRuntime(Pin.Type))
+					{
+						return false;
+					}
+				}
+			}
+
+			for (const FVoxelMetaGraphParameter& Parameter : Graph->Parameters)
+			{
+				if (DependsOnRuntime(Parameter.Type))
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	// Records the assets referenced by the compiled graphs & variables
+	class FKeyArchive : public FObjectAndNameAsStringProxyArchive
+	{
+	public:
+		TSet<const UObject*> Objects;
+
+		using FObjectAndNameAsStringProxyArchive::FObjectAndNameAsStringProxyArchive;
+		using FObjectAndNameAsStringProxyArchive::operator<<;
+
+		virtual FArchive& operator<<(UObject*& Object) override
+		{
+			if (Object)
+			{
+				Objects.Add(Object);
+			}
+			return FObjectAndNameAsStringProxyArchive::operator<<(Object);
+		}
+	};
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	FKeyArchive Ar(Writer, false);
+
+	for (const UVoxelMetaGraph* Graph : Graphs)
+	{
+		FString Path = Graph->GetPathName();
+		Ar << Path;
+
+		OutObjects.Add(Graph);
+
+		FVoxelMetaGraphCompiledGraph::StaticStruct()->SerializeItem(Ar, VOXEL_CONST_CAST(&Graph->CompiledGraph), nullptr);
+
+		for (const FVoxelMetaGraphParameter& Parameter : Graph->Parameters)
+		{
+			FVoxelMetaGraphParameter::StaticStruct()->SerializeItem(Ar, VOXEL_CONST_CAST(&Parameter), nullptr);
+		}
+	}
+
+	FVoxelMetaGraphVariableCollection::StaticStruct()->SerializeItem(Ar, VOXEL_CONST_CAST(&Variables), nullptr);
+
+	for (const UObject* Object : Ar.Objects)
+	{
+		OutObjects.Add(Object);
+	}
+
+	OutKey = CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), Bytes.Num());
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 bool FCompilerUtilities::MakeDefaultValue(
 	const FVoxelPinType& Type,
 	const FVoxelPinValue& ExposedDefaultValue,
@@ -109,23 +109,17 @@ void FRuntimeUtilities::WriteIntPositions_Unpacked(
 	ensure(OutPositionY.Num() == Size.X * Size.Y * Size.Z);
 	ensure(OutPositionZ.Num() == Size.X * Size.Y * Size.Z);
 
-	int32 Index = 0;
-	for (int32 Z = 0; Z < Size.Z; Z++)
-	{
-		for (int32 Y = 0; Y < Size.Y; Y++)
-		{
-			for (int32 X = 0; X < Size.X; X++)
-			{
-				checkVoxelSlow(Index == FVoxelUtilities::Get3DIndex<int32>(Size, X, Y, Z));
-
-				OutPositionX[Index] = Start.X + X * Step;
-				OutPositionY[Index] = Start.Y + Y * Step;
-				OutPositionZ[Index] = Start.Z + Z * Step;
-
-				Index++;
-			}
-		}
-	}
+	ispc::MetaGraph_WriteIntPositions_Unpacked(
+		OutPositionX.GetData(),
+		OutPositionY.GetData(),
+		OutPositionZ.GetData(),
+		Size.X,
+		Size.Y,
+		Size.Z,
+		Start.X,
+		Start.Y,
+		Start.Z,
+		Step);
 }
 
 void FRuntimeUtilities::ReplicatePacked(
@@ -8,6 +8,42 @@
 
 struct FVoxelMeshMaterial;
 
+DECLARE_VOXEL_MEMORY_STAT(VOXELMETAGRAPH_API, STAT_VoxelMarchingCubeCompactVerticesSavings, "Voxel Marching Cube Compact Vertices Savings");
+
+// 16 bit positions, normalized to [-1, 1]
+// Dequantized by the mesh component scale, see FVoxelMarchingCubeMesh_LocalVF::GetScale
+class VOXELMETAGRAPH_API FVoxelMarchingCubeCompactPositionVertexBuffer : public FVertexBuffer
+{
+public:
+	struct FPosition
+	{
+		int16 X = 0;
+		int16 Y = 0;
+		int16 Z = 0;
+		int16 W = MAX_int16;
+	};
+	TVoxelArray<FPosition> Positions;
+
+	FORCEINLINE int32 GetNumVertices() const
+	{
+		return NumVertices;
+	}
+	FORCEINLINE int32 GetStride() const
+	{
+		return sizeof(FPosition);
+	}
+
+	void Init(int32 InNumVertices);
+	void BindPositionVertexBuffer(const FVertexFactory* VertexFactory, FLocalVertexFactory::FDataType& Data) const;
+
+	//~ Begin FRenderResource Interface
+	virtual void InitRHI() override;
+	//~ End FRenderResource Interface
+
+private:
+	int32 NumVertices = 0;
+};
+
 USTRUCT()
 struct VOXELMETAGRAPH_API FVoxelMarchingCubeMesh_LocalVF : public FVoxelMesh
 {
@@ -19,17 +55,28 @@ public:
 	FBox Bounds = FBox(ForceInit);
 	TSharedPtr<const FVoxelMeshMaterial> MeshMaterial;
 	
+	// If true, positions are quantized in CompactPositionVertexBuffer and UVs are half precision
+	bool bCompactVertices = false;
+	// Only used if bCompactVertices, PositionVertexBuffer is empty then
+	float PositionScale = 1.f;
+	// Vertex memory saved compared to the full precision layout
+	int64 CompactBytesSaved = 0;
+
 	FRawStaticIndexBuffer IndexBuffer{ false };
 
 	FPositionVertexBuffer PositionVertexBuffer;
 	// Holds UVs + tangents/normals
 	FStaticMeshVertexBuffer StaticMeshVertexBuffer;
 	FColorVertexBuffer ColorVertexBuffer;
+	FVoxelMarchingCubeCompactPositionVertexBuffer CompactPositionVertexBuffer;
 
 public:
+	virtual ~FVoxelMarchingCubeMesh_LocalVF() override;
+
 	virtual FBox GetBounds() const override { return Bounds; }
 	virtual int64 GetAllocatedSize() const override;
 	virtual TSharedPtr<FVoxelMaterialRef> GetMaterial() const override { return Material; }
+	virtual FVector GetScale() const override;
 
 	virtual void Initialize_GameThread() override;
 
@@ -39,6 +86,8 @@ public:
 	virtual bool Draw_RenderThread(const FPrimitiveSceneProxy& Proxy, FMeshBatch& MeshBatch) const override;
 	virtual const FRayTracingGeometry* DrawRaytracing_RenderThread(const FPrimitiveSceneProxy& Proxy, FMeshBatch& MeshBatch) const override;
 
+	int32 GetNumVertices() const;
+
 private:
 	TSharedPtr<FLocalVertexFactory> VertexFactory;
 	TSharedPtr<FRayTracingGeometry> RayTracingGeometry;
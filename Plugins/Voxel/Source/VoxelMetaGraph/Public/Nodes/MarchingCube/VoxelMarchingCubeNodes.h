@@ -69,6 +69,8 @@ struct VOXELMETAGRAPH_API FVoxelNode_FVoxelMarchingCubeSurface_CreateNavmesh : p
 	VOXEL_OUTPUT_PIN(FVoxelNavmesh, Navmesh);
 };
 
+// @param	CompactVertices	If true positions will be quantized to 16 bits and UVs to half precision. Disables raytracing for this mesh
+// @param	OptimizeMesh	If true triangles & vertices will be reordered for better GPU vertex cache reuse and less overdraw
 USTRUCT(Category = "Mesh|MarchingCube")
 struct VOXELMETAGRAPH_API FVoxelNode_FVoxelMarchingCubeSurface_CreateMesh : public FVoxelNode
 {
@@ -78,5 +80,7 @@ struct VOXELMETAGRAPH_API FVoxelNode_FVoxelMarchingCubeSurface_CreateMesh : publ
 	VOXEL_INPUT_PIN(FVoxelMarchingCubeSurface, Surface, nullptr);
 	VOXEL_INPUT_PIN(FVoxelVertexData, VertexData, nullptr);
 	VOXEL_INPUT_PIN(FVoxelMeshMaterial, Material, nullptr);
+	VOXEL_INPUT_PIN(bool, CompactVertices, false);
+	VOXEL_INPUT_PIN(bool, OptimizeMesh, false);
 	VOXEL_OUTPUT_PIN(FVoxelMesh, Mesh);
 };
\ No newline at end of file
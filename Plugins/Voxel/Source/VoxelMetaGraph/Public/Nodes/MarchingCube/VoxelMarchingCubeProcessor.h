@@ -46,4 +46,11 @@ struct FVoxelMarchingCubeProcessor
 		TVoxelArray<float>& OutVerticesX,
 		TVoxelArray<float>& OutVerticesY,
 		TVoxelArray<float>& OutVerticesZ) const;
+
+	// Reorders triangles for vertex cache reuse & overdraw, then vertices for fetch locality
+	// Indices are remapped in place, OutNewToOldVertex[NewIndex] is the source vertex of each output vertex
+	static void OptimizeMesh(
+		TVoxelArray<uint32>& Indices,
+		TConstVoxelArrayView<FVector3f> Positions,
+		TVoxelArray<int32>& OutNewToOldVertex);
 };
\ No newline at end of file
@@ -78,6 +78,11 @@ struct FVoxelNode_Clamp : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = clamp({Value}, {Min}, {Max})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalClamp(Inputs[0], Inputs[1], Inputs[2]);
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -95,6 +100,11 @@ struct FVoxelNode_Clamp_Int : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = clamp({Value}, {Min}, {Max})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalClamp(Inputs[0], Inputs[1], Inputs[2]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Misc")
@@ -134,6 +144,12 @@ struct FVoxelNode_MappedRangeValueClamped : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = lerp({OutMin}, {OutMax}, clamp(({Value} - {InMin}) / ({InMax} - {InMin}), 0.f, 1.f))";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		// Alpha is clamped, only the output range matters
+		Outputs[0] = FVoxelUtilities::IntervalLerp(Inputs[3], Inputs[4], FFloatInterval(0.f, 1.f));
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Misc")
@@ -50,6 +50,11 @@ struct FVoxelNode_Lerp : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = lerp({A}, {B}, {Alpha})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalLerp(Inputs[0], Inputs[1], Inputs[2]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Misc")
@@ -83,6 +88,11 @@ struct FVoxelNode_SafeLerp : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = lerp({A}, {B}, clamp({Alpha}, 0.f, 1.f))";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalLerp(Inputs[0], Inputs[1], FVoxelUtilities::IntervalClamp(Inputs[2], FVoxelUtilities::ConstantInterval(0.f), FVoxelUtilities::ConstantInterval(1.f)));
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Misc")
@@ -47,6 +47,11 @@ struct FVoxelNode_Ceil : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = (int)ceil({Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMonotonic(Inputs[0], [](const float Value) { return FMath::CeilToFloat(Value); });
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -62,6 +67,11 @@ struct FVoxelNode_CeilToFloat : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = ceil({Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMonotonic(Inputs[0], [](const float Value) { return FMath::CeilToFloat(Value); });
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Operators")
@@ -97,6 +107,11 @@ struct FVoxelNode_Round : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = (int)round({Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMonotonic(Inputs[0], [](const float Value) { return FMath::RoundToFloat(Value); });
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -112,6 +127,11 @@ struct FVoxelNode_RoundToFloat : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = round({Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMonotonic(Inputs[0], [](const float Value) { return FMath::RoundToFloat(Value); });
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Operators")
@@ -147,6 +167,11 @@ struct FVoxelNode_Floor : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = (int)floor({Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMonotonic(Inputs[0], [](const float Value) { return FMath::FloorToFloat(Value); });
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -162,6 +187,11 @@ struct FVoxelNode_FloorToFloat : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = floor({Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMonotonic(Inputs[0], [](const float Value) { return FMath::FloorToFloat(Value); });
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Operators")
@@ -101,6 +101,11 @@ struct FVoxelNode_Add : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = {A} + {B}";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalAdd(Inputs[0], Inputs[1]);
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -153,6 +158,11 @@ struct FVoxelNode_Subtract : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = {A} - {B}";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSubtract(Inputs[0], Inputs[1]);
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -205,6 +215,11 @@ struct FVoxelNode_Multiply : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = {A} * {B}";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMultiply(Inputs[0], Inputs[1]);
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -257,6 +272,11 @@ struct FVoxelNode_Divide : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = {A} / {B}";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalDivide(Inputs[0], Inputs[1]);
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -316,6 +336,11 @@ struct FVoxelNode_Min : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = min({A}, {B})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMin(Inputs[0], Inputs[1]);
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -332,6 +357,11 @@ struct FVoxelNode_Min_Int : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = min({A}, {B})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMin(Inputs[0], Inputs[1]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Operators", meta = (CompactNodeTitle = "MIN"))
@@ -368,6 +398,11 @@ struct FVoxelNode_Max : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = max({A}, {B})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMax(Inputs[0], Inputs[1]);
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -384,6 +419,11 @@ struct FVoxelNode_Max_Int : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = max({A}, {B})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalMax(Inputs[0], Inputs[1]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Operators", meta = (CompactNodeTitle = "MAX"))
@@ -419,6 +459,11 @@ struct FVoxelNode_Abs : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = abs({Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalAbs(Inputs[0]);
+		return true;
+	}
 };
 
 USTRUCT(meta = (Internal))
@@ -469,6 +514,11 @@ struct FVoxelNode_OneMinus : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = 1 - {Value}";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSubtract(FVoxelUtilities::ConstantInterval(1.f), Inputs[0]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Operators", meta = (CompactNodeTitle = "1-X"))
@@ -38,4 +38,41 @@ public:
 	VOXEL_INPUT_PIN_ARRAY(FVoxelFloatBuffer, OctaveStrength, 1.f, 1);
 
 	VOXEL_OUTPUT_PIN(FVoxelFloatBuffer, Value);
-};
\ No newline at end of file
+
+	virtual bool OnlyDependsOnInputs() const override
+	{
+		return true;
+	}
+};
+
+// Fused fBm: all the octaves are computed in a single pass, without intermediate buffers
+USTRUCT(Category = "Noise")
+struct VOXELMETAGRAPH_API FVoxelNode_AdvancedNoise3D : public FVoxelNode
+{
+	GENERATED_BODY()
+	GENERATED_VOXEL_NODE_BODY()
+
+public:
+	VOXEL_INPUT_PIN(FVoxelVectorBuffer, Position, nullptr);
+	// Each octave drifts in its own direction as time increases, making the noise evolve
+	VOXEL_INPUT_PIN(FVoxelFloatBuffer, Time, 0.f);
+	VOXEL_INPUT_PIN(FVoxelFloatBuffer, Amplitude, 10000);
+	VOXEL_INPUT_PIN(FVoxelFloatBuffer, FeatureScale, 100000);
+	VOXEL_INPUT_PIN(FVoxelFloatBuffer, Lacunarity, 2.f);
+	VOXEL_INPUT_PIN(FVoxelFloatBuffer, Gain, 0.5f);
+	VOXEL_INPUT_PIN(FVoxelFloatBuffer, CellularJitter, 0.9f);
+	VOXEL_INPUT_PIN(int32, NumOctaves, 10);
+	VOXEL_INPUT_PIN(int32, Seed, nullptr, SeedPin);
+	VOXEL_INPUT_PIN(uint8, DefaultOctaveType, nullptr, EnumPin<EVoxelAdvancedNoiseOctaveType>, PropertyBind);
+	VOXEL_INPUT_PIN_ARRAY(uint8, OctaveType, nullptr, 1, EnumPin<EVoxelAdvancedNoiseOctaveType>);
+	VOXEL_INPUT_PIN_ARRAY(FVoxelFloatBuffer, OctaveStrength, 1.f, 1);
+
+	VOXEL_OUTPUT_PIN(FVoxelFloatBuffer, Value);
+	// Analytic gradient of Value relative to Position, ignoring Time
+	VOXEL_OUTPUT_PIN(FVoxelVectorBuffer, Gradient);
+
+	virtual bool OnlyDependsOnInputs() const override
+	{
+		return true;
+	}
+};
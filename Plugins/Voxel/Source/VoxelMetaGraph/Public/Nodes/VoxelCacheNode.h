@@ -58,6 +58,51 @@ public:
 	void Cleanup(const TSharedRef<FNodeCache>& NodeCache);
 };
 
+UCLASS()
+class VOXELMETAGRAPH_API UVoxelSharedPinValueSubsystemProxy : public UVoxelSubsystemProxy
+{
+	GENERATED_BODY()
+	GENERATED_VOXEL_SUBSYSTEM_PROXY_BODY(FVoxelSharedPinValueSubsystem);
+};
+
+// Shares the value of an input pin between all the nodes linked to the same output pin and queried with identical queries,
+// eg between the render, collision and navmesh chunks of a region
+// Unlike the cache node, values are only kept for voxel.metagraph.SharedPinValueLifetime seconds
+class VOXELMETAGRAPH_API FVoxelSharedPinValueSubsystem : public IVoxelSubsystem
+{
+public:
+	GENERATED_VOXEL_SUBSYSTEM_BODY(UVoxelSharedPinValueSubsystemProxy);
+
+	//~ Begin IVoxelSubsystem Interface
+	virtual void Tick() override;
+	//~ End IVoxelSubsystem Interface
+
+	FVoxelFutureValue Get(const FVoxelNodeRuntime& NodeRuntime, const FVoxelPinRef& Pin, const FVoxelQuery& Query);
+
+private:
+	using FQueryCache = TVoxelQueryMap<TSharedPtr<FVoxelCachedValueRef>>;
+
+	struct FPinCache
+	{
+		// Keep the pin data alive so that its address isn't reused
+		const TSharedRef<const FVoxelNodeRuntime::FPinData> OutputPinData;
+		FQueryCache QueryCache;
+
+		explicit FPinCache(const TSharedRef<const FVoxelNodeRuntime::FPinData>& OutputPinData)
+			: OutputPinData(OutputPinData)
+		{
+		}
+	};
+
+	TVoxelKeyedCriticalSection<FVoxelCachedValueId> ValueCriticalSection;
+	FVoxelCriticalSection CriticalSection;
+	TMap<const FVoxelNodeRuntime::FPinData*, TSharedPtr<FPinCache>> PinCaches;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 USTRUCT(Category = "Misc")
 struct VOXELMETAGRAPH_API FVoxelNode_Cache : public FVoxelNode
 {
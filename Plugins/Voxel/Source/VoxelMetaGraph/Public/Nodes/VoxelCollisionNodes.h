@@ -19,8 +19,10 @@ public:
 	TSharedPtr<const FBodyInstance> BodyInstance;
 	TSharedPtr<const FVoxelCollider> Collider;
 
+	virtual bool IsGameplayRelevant() const override { return true; }
 	virtual void Create(FVoxelRuntime& Runtime) const override;
 	virtual void Destroy(FVoxelRuntime& Runtime) const override;
+	virtual int64 GetAllocatedSize() const override;
 
 private:
 	mutable FVoxelCollisionProcessorId CollisionId;
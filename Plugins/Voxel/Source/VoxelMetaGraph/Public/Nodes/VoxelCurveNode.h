@@ -13,6 +13,14 @@ struct VOXELMETAGRAPH_API FVoxelCurveData
 	GENERATED_BODY()
 
 	TSharedPtr<const FRichCurve> Curve;
+
+	// Curve baked into a uniform lookup table over [LUTMinTime, LUTMaxTime], sampled with linear interpolation
+	// Empty if the curve cannot be baked, eg if its extrapolation isn't constant
+	float LUTMinTime = 0.f;
+	float LUTMaxTime = 0.f;
+	TVoxelArray<float> LUT;
+
+	void BakeLUT();
 };
 
 USTRUCT()
@@ -30,6 +38,7 @@ struct VOXELMETAGRAPH_API FVoxelCurveDataPinType : public FVoxelExposedPinType
 
 		const TSharedRef<FVoxelCurveData> CurveData = MakeShared<FVoxelCurveData>();
 		CurveData->Curve = MakeSharedCopy(Curve->FloatCurve);
+		CurveData->BakeLUT();
 		return CurveData;
 	}
 };
@@ -43,4 +52,9 @@ struct VOXELMETAGRAPH_API FVoxelNode_SampleCurve : public FVoxelNode
 	VOXEL_INPUT_PIN(FVoxelCurveData, Curve, nullptr);
 	VOXEL_MATH_INPUT_PIN(float, Value, nullptr);
 	VOXEL_MATH_OUTPUT_PIN(float, Result);
+
+	virtual bool OnlyDependsOnInputs() const override
+	{
+		return true;
+	}
 };
\ No newline at end of file
@@ -21,6 +21,8 @@ struct VOXELMETAGRAPH_API FVoxelDistanceField : public FVoxelVirtualStruct
 	int32 Priority = 0;
 
 	virtual TVoxelFutureValue<FVoxelFloatBuffer> GetDistances(const FVoxelQuery& Query) const VOXEL_PURE_VIRTUAL({});
+	// Conservative range of the distances inside Bounds, unset if unknown
+	virtual TOptional<FFloatInterval> GetDistanceRange(const FVoxelBox& Bounds) const { return {}; }
 };
 
 USTRUCT()
@@ -83,6 +85,8 @@ struct VOXELMETAGRAPH_API FVoxelNode_CombineDistanceFields : public FVoxelNode
 	VOXEL_OUTPUT_PIN(FVoxelDistanceField, DistanceField);
 };
 
+// Distances further than MinExactDistance from the surface are not exact
+// If the entire query is provably further than that, a constant is returned
 USTRUCT(Category = "Distance Field")
 struct VOXELMETAGRAPH_API FVoxelNode_ComputeDensityFromDistanceField : public FVoxelNode
 {
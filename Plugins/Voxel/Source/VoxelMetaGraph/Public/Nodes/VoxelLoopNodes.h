@@ -6,6 +6,8 @@
 #include "VoxelNode.h"
 #include "VoxelLoopNodes.generated.h"
 
+struct FVoxelNode_ExecCodeGen;
+
 USTRUCT()
 struct VOXELMETAGRAPH_API FVoxelWhileLoopQueryData : public FVoxelQueryData
 {
@@ -56,10 +58,52 @@ struct VOXELMETAGRAPH_API FVoxelNode_WhileLoop : public FVoxelNode
 		
 	VOXEL_GENERIC_INPUT_PIN(FirstValue);
 	VOXEL_GENERIC_INPUT_PIN(NextValue);
-	VOXEL_INPUT_PIN(bool, Continue, false);
+	// Either a bool, or a bool buffer to run the loop per lane
+	VOXEL_MATH_INPUT_PIN(bool, Continue, false);
 
 	VOXEL_GENERIC_OUTPUT_PIN(Result);
 
+	FVoxelNode_WhileLoop();
+
+	//~ Begin FVoxelNode Interface
+	virtual void Initialize() override;
 	virtual FVoxelPinTypeSet GetPromotionTypes(const FVoxelPin& Pin) const override;
 	virtual void PromotePin(FVoxelPin& Pin, const FVoxelPinType& NewType) override;
+	//~ End FVoxelNode Interface
+
+protected:
+	enum class ENativeInput : uint8
+	{
+		// The previous value
+		Value,
+		// The loop index
+		Index,
+		// Doesn't depend on the loop, queried once
+		Invariant
+	};
+	struct FNativeBody
+	{
+		const FVoxelNode_ExecCodeGen* Node = nullptr;
+		TVoxelArray<ENativeInput> Inputs;
+	};
+	struct FNativeLoop
+	{
+		FNativeBody Continue;
+		FNativeBody NextValue;
+	};
+	// Set if Continue and NextValue are both codegen, in which case per-lane loops
+	// are iterated directly instead of querying the body at every iteration
+	TSharedPtr<const FNativeLoop> NativeLoop;
+
+	bool MakeNativeBody(const FVoxelPinRef& Pin, FNativeBody& OutBody) const;
+	static bool DependsOnLoop(const FVoxelNode& Node, TSet<const FVoxelNode*>& VisitedNodes);
+
+	FVoxelSharedPinValue RunNativeLoop(
+		int32 NumLanes,
+		const FVoxelSharedPinValue& FirstValue,
+		const TArray<TSharedRef<const FVoxelBuffer>>& ContinueInvariants,
+		const TArray<TSharedRef<const FVoxelBuffer>>& NextValueInvariants) const;
+
+	// Removes the lanes where Condition is false
+	static FVoxelSharedPinValue FilterLanes(const FVoxelSharedPinValue& Value, const FVoxelBoolBufferView& Condition);
 };
\ No newline at end of file
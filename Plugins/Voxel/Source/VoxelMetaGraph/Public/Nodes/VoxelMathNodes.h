@@ -36,6 +36,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_Sin : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = sin({Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSin(Inputs[0]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Trig", DisplayName = "Sin (Degrees)", meta = (CompactNodeTitle = "SINd"))
@@ -51,6 +56,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_SinDegrees : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = sin(PI / 180.f * {Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSin(FVoxelUtilities::IntervalMultiply(Inputs[0], FVoxelUtilities::ConstantInterval(PI / 180.f)));
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Trig", DisplayName = "Cos (Radians)", meta = (CompactNodeTitle = "COS"))
@@ -66,6 +76,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_Cos : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = cos({Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalCos(Inputs[0]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Trig", DisplayName = "Cos (Degrees)", meta = (CompactNodeTitle = "COSd"))
@@ -81,6 +96,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_CosDegrees : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = cos(PI / 180.f * {Value})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalCos(FVoxelUtilities::IntervalMultiply(Inputs[0], FVoxelUtilities::ConstantInterval(PI / 180.f)));
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Trig", DisplayName = "Tan (Radians)", meta = (CompactNodeTitle = "TAN"))
@@ -345,6 +365,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_SmoothMin : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = SmoothMin({DistanceA}, {DistanceB}, {Smoothness})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSmoothMin(Inputs[0], Inputs[1], Inputs[2]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Float")
@@ -362,6 +387,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_SmoothMax : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = SmoothMax({DistanceA}, {DistanceB}, {Smoothness})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSmoothMax(Inputs[0], Inputs[1], Inputs[2]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Float")
@@ -379,6 +409,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_SmoothSubtraction : public FVoxelNode_CodeG
 	{
 		return "{ReturnValue} = SmoothSubtraction({DistanceA}, {DistanceB}, {Smoothness})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSmoothSubtraction(Inputs[0], Inputs[1], Inputs[2]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Boolean", DisplayName = "NOT Boolean", meta = (Keywords = "! not negate", CompactNodeTitle = "NOT"))
@@ -442,6 +477,12 @@ struct VOXELMETAGRAPH_API FVoxelNode_MakeDensityFromHeight : public FVoxelNode_C
 	{
 		return "{ReturnValue} = {Position}.z - {Height}";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		// Position is 3 registers
+		Outputs[0] = FVoxelUtilities::IntervalSubtract(Inputs[2], Inputs[3]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Density")
@@ -459,6 +500,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_Density_SmoothUnion : public FVoxelNode_Cod
 	{
 		return "{ReturnValue} = SmoothMin({DistanceA}, {DistanceB}, {Smoothness})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSmoothMin(Inputs[0], Inputs[1], Inputs[2]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Density")
@@ -476,6 +522,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_Density_SmoothIntersection : public FVoxelN
 	{
 		return "{ReturnValue} = SmoothMax({DistanceA}, {DistanceB}, {Smoothness})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSmoothMax(Inputs[0], Inputs[1], Inputs[2]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Density")
@@ -493,6 +544,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_Density_SmoothSubtraction : public FVoxelNo
 	{
 		return "{ReturnValue} = SmoothSubtraction({DistanceA}, {DistanceB}, {Smoothness})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalSmoothSubtraction(Inputs[0], Inputs[1], Inputs[2]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Density")
@@ -508,6 +564,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_Density_Invert : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = -{Density}";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FVoxelUtilities::IntervalNegate(Inputs[0]);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Conversions", DisplayName = "To Float (Integer)", meta = (Keywords = "cast convert", CompactNodeTitle = "->", Autocast))
@@ -523,6 +584,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_Conv_IntToFloat : public FVoxelNode_CodeGen
 	{
 		return "{ReturnValue} = (float){Value}";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = Inputs[0];
+		return true;
+	}
 };
 
 USTRUCT(Category = "Math|Integer")
@@ -56,6 +56,7 @@ public:
 
 	virtual void Create(FVoxelRuntime& Runtime) const override;
 	virtual void Destroy(FVoxelRuntime& Runtime)const  override;
+	virtual int64 GetAllocatedSize() const override;
 
 private:
 	mutable FVoxelMeshRendererId MeshId;
@@ -15,11 +15,13 @@ struct VOXELMETAGRAPH_API FVoxelChunkExecObject_CreateNavmeshComponent : public
 	GENERATED_VIRTUAL_STRUCT_BODY()
 
 public:
-	FVector3d Position = FVector3d::ZeroVector;
-	TSharedPtr<const FVoxelNavmesh> Navmesh;
+	FVoxelBox Bounds;
+	TMap<FIntVector, TSharedPtr<const FVoxelNavmesh>> NavmeshCells;
 
+	virtual bool IsGameplayRelevant() const override { return true; }
 	virtual void Create(FVoxelRuntime& Runtime) const override;
 	virtual void Destroy(FVoxelRuntime& Runtime) const override;
+	virtual int64 GetAllocatedSize() const override;
 
 private:
 	mutable FVoxelNavmeshProcessorId NavmeshId;
@@ -103,6 +103,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_PerlinNoise2D : public FVoxelNode_CodeGen
 	{
 		return "{Value} = GetPerlin2D({Seed}, {Position})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FFloatInterval(-1.f, 1.f);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Noise")
@@ -119,6 +124,11 @@ struct VOXELMETAGRAPH_API FVoxelNode_PerlinNoise3D : public FVoxelNode_CodeGen
 	{
 		return "{Value} = GetPerlin3D({Seed}, {Position})";
 	}
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const override
+	{
+		Outputs[0] = FFloatInterval(-1.f, 1.f);
+		return true;
+	}
 };
 
 USTRUCT(Category = "Noise")
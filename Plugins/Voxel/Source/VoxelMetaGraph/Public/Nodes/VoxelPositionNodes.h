@@ -36,6 +36,8 @@ public:
 	virtual bool Is2D() const { return false; }
 	virtual int32 GetGradientStride(EVoxelAxis Axis) const { return -1; }
 	virtual FVoxelVectorBuffer GetPositions() const VOXEL_PURE_VIRTUAL({});
+	// Number of positions, doesn't allocate them
+	virtual int32 Num() const { return GetPositions().Num(); }
 	virtual TSharedPtr<FVoxelPositionQueryData> TryCull(const FVoxelBox& Bounds) const { return nullptr; }
 
 private:
@@ -78,6 +80,10 @@ public:
 	{
 		return PrivatePositions;
 	}
+	virtual int32 Num() const override
+	{
+		return PrivatePositions.Num();
+	}
 
 	void Initialize(
 		bool bInIs2D,
@@ -132,9 +138,11 @@ public:
 		case EVoxelAxis::Z: return 4;
 		}
 	}
-	virtual FVoxelVectorBuffer GetPositions() const override
+	// Will allocate the positions buffer the first time it's called on the CPU
+	virtual FVoxelVectorBuffer GetPositions() const override;
+	virtual int32 Num() const override
 	{
-		return CachedPositions;
+		return PrivateSize.X * PrivateSize.Y * PrivateSize.Z;
 	}
 	virtual TSharedPtr<FVoxelPositionQueryData> TryCull(const FVoxelBox& Bounds) const override;
 
@@ -168,7 +176,8 @@ private:
 	float PrivateStep = 0.f;
 	FIntVector PrivateSize = FIntVector::ZeroValue;
 
-	FVoxelVectorBuffer CachedPositions;
+	mutable FVoxelCriticalSection CriticalSection;
+	mutable TOptional<FVoxelVectorBuffer> CachedPositions_RequiresLock;
 
 	uint64 GetHash() const
 	{
@@ -211,9 +220,11 @@ public:
 		case EVoxelAxis::Z: return -1;
 		}
 	}
-	virtual FVoxelVectorBuffer GetPositions() const override
+	// Will allocate the positions buffer the first time it's called
+	virtual FVoxelVectorBuffer GetPositions() const override;
+	virtual int32 Num() const override
 	{
-		return CachedPositions;
+		return PrivateSize.X * PrivateSize.Y;
 	}
 
 	FVoxelBox2D GetBounds() const
@@ -233,7 +244,8 @@ private:
 	float PrivateStep = 0.f;
 	FIntPoint PrivateSize = FIntPoint::ZeroValue;
 
-	FVoxelVectorBuffer CachedPositions;
+	mutable FVoxelCriticalSection CriticalSection;
+	mutable TOptional<FVoxelVectorBuffer> CachedPositions_RequiresLock;
 
 	uint64 GetHash() const
 	{
@@ -266,6 +278,10 @@ public:
 	{
 		return PrivatePositions;
 	}
+	virtual int32 Num() const override
+	{
+		return PrivatePositions.Num();
+	}
 
 	void Initialize(const FVoxelVectorBuffer& Positions);
 	
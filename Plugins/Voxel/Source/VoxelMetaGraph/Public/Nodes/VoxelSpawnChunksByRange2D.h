@@ -18,6 +18,9 @@ struct VOXELMETAGRAPH_API FVoxelExecNode_SpawnChunksByRange2D : public FVoxelExe
 
 	VOXEL_INPUT_PIN(float, ChunkSize, 3200.f);
 	VOXEL_INPUT_PIN(int32, RenderDistanceInChunks, 5);
+	// If true, the render distance is reduced while over voxel.chunkmanager.MemoryBudget
+	// Keep false for collision & navmesh chunks, which need to stay around the player
+	VOXEL_INPUT_PIN(bool, ScaleWithMemoryBudget, false);
 
 	virtual TValue<FVoxelExecObject> Execute(const FVoxelQuery& Query) const override;
 };
@@ -31,6 +34,7 @@ struct VOXELMETAGRAPH_API FVoxelExecObject_SpawnChunksByRange2D : public FVoxelE
 public:
 	float ChunkSize = 0;
 	int32 RenderDistanceInChunks = 0;
+	bool bScaleWithMemoryBudget = false;
 
 	//~ Begin FVoxelExecObject Interface
 	virtual void Tick(FVoxelRuntime& Runtime) override;
@@ -39,6 +43,7 @@ public:
 private:
 	bool bUpdateInProgress = false;
 	FVector LastCameraPosition = FVector::ZeroVector;
+	float LastDetailScale = 1.f;
 
 	struct FVisibleChunks
 	{
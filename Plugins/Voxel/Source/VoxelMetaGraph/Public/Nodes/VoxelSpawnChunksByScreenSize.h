@@ -54,6 +54,7 @@ private:
 	TSharedPtr<const FOctree> Octree;
 	bool bTaskInProgress = false;
 	FVector LastLocalViewOrigin = FVector(MAX_dbl);
+	float LastDetailScale = 1.f;
 	
 	struct FPreviousChunks
 	{
@@ -75,7 +76,7 @@ private:
 	FVoxelCriticalSection CriticalSection;
 	TMap<FChunkId, TSharedPtr<FChunk>> Chunks;
 
-	void UpdateTree(FVoxelRuntime& Runtime, const FVector& LocalViewOrigin);
+	void UpdateTree(FVoxelRuntime& Runtime, const FVector& LocalViewOrigin, float DetailScale);
 };
 
 BEGIN_VOXEL_NAMESPACE(SpawnChunksByScreenSize)
@@ -99,6 +100,8 @@ class FOctree : public TVoxelFlatOctree<FNodeData>
 {
 public:
 	const FVector LocalViewOrigin;
+	// See FVoxelChunkManager::GetDetailScale
+	const float DetailScale;
 	const FVoxelExecObject_SpawnChunksByScreenSize& Object;
 
 	static constexpr int32 ChunkSize = 8;
@@ -106,9 +109,11 @@ public:
 	FOctree(
 		const int32 Depth,
 		const FVector& LocalViewOrigin,
+		const float DetailScale,
 		const FVoxelExecObject_SpawnChunksByScreenSize& Object)
 		: TVoxelFlatOctree<FNodeData>(ChunkSize, Depth)
 		, LocalViewOrigin(LocalViewOrigin)
+		, DetailScale(DetailScale)
 		, Object(Object)
 	{
 	}
@@ -19,6 +19,10 @@ public:
 	
 public:
 	static TSharedRef<FVoxelBufferData> Filter_Cpu(const FVoxelTerminalBufferView& Buffer, const FVoxelBoolBufferView& Condition);
+	// Data[Indices[Index]] = Values[Index], negative indices are skipped
+	// Data is the raw data of a buffer with the same inner type as Values
+	// Returns false if Values is neither constant nor the same size as Indices
+	static bool Scatter_Cpu(TVoxelArrayView<uint8> Data, const FVoxelTerminalBufferView& Values, TConstVoxelArrayView<int32> Indices);
 	static TSharedRef<FVoxelBufferData> Select_Cpu(TConstVoxelArrayView<int32> Indices, TConstVoxelArrayView<const FVoxelTerminalBufferView*> Buffers);
 	static TSharedRef<FVoxelBufferData> ExpandQuery2D_Cpu(const FVoxelTerminalBufferView& Buffer, int32 Count);
 };
\ No newline at end of file
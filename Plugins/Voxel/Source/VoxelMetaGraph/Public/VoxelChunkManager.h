@@ -7,9 +7,11 @@
 #include "VoxelExecNode.h"
 
 DECLARE_UNIQUE_VOXEL_ID(FVoxelChunkId);
+DECLARE_VOXEL_MEMORY_STAT(VOXELMETAGRAPH_API, STAT_VoxelChunkObjectsMemory, "Voxel Chunk Objects Memory");
 
 extern VOXELMETAGRAPH_API bool GVoxelChunkSpawnerFreeze;
 extern VOXELMETAGRAPH_API float GVoxelChunkSpawnerCameraRefreshThreshold;
+extern VOXELMETAGRAPH_API float GVoxelChunkSpawnerDetailScaleRefreshThreshold;
 
 enum class EVoxelChunkAction
 {
@@ -144,6 +146,13 @@ public:
 		FName PinName,
 		const FVoxelNode& Node,
 		const FVoxelQuery& Query);
+
+public:
+	// Memory used by the objects of all the chunks, across all chunk managers
+	static int64 GetAllocatedSize();
+	// Lowered down to voxel.chunkmanager.MinDetailScale while over voxel.chunkmanager.MemoryBudget
+	// Chunk spawners should scale their view distance by it
+	static float GetDetailScale();
 	
 private:
 	void InvalidateDependencies(const TSet<TSharedPtr<FVoxelDependency>>& Dependencies);
@@ -167,6 +176,11 @@ private:
 		TArray<TSharedPtr<FVoxelDependency>> Dependencies_GameThread;
 		TArray<TSharedPtr<const FVoxelChunkExecObject>> ChunkObjects_GameThread;
 		TArray<TSharedPtr<FVoxelPendingChunk>> PendingChunks_GameThread;
+		bool bHasCompleted_GameThread = false;
+		int64 AllocatedSize_GameThread = 0;
+		bool bIsEvicted_GameThread = false;
+		// Allocated size when evicted, kept until the chunk is recreated
+		int64 EvictedSize_GameThread = 0;
 
 		FChunkInfo(
 			FName PinName,
@@ -210,6 +224,24 @@ private:
 	TSharedPtr<FVoxelPendingChunksCounter> PendingChunksCounter;
 	TWeakPtr<FVoxelExecObject> WeakOwner;
 
+	// Game thread work is time sliced, see voxel.chunkmanager.GameThreadBudget
+	struct FPendingDestroy
+	{
+		TSharedPtr<FChunkInfo> ChunkInfo;
+		double Time = 0.;
+	};
+	TVoxelArray<TPair<FTaskCompletion, TSharedPtr<FChunkInfo>>> PendingTaskCompletions_GameThread;
+	TVoxelArray<FPendingDestroy> PendingDestroys_GameThread;
+	// Upper bound: chunks destroyed while evicted are only accounted for on the next recreate pass
+	int32 NumEvictedChunks_GameThread = 0;
+
+	void ProcessPendingWork(FVoxelRuntime& Runtime, bool bFlush);
+	void ApplyTaskCompletion(FVoxelRuntime& Runtime, FTaskCompletion& TaskCompletion, FChunkInfo& ChunkInfo);
+	static void DestroyChunkObjects(FVoxelRuntime& Runtime, FChunkInfo& ChunkInfo);
+
+	static void UpdateDetailScale();
+	void UpdateEvictedChunks(FVoxelRuntime& Runtime);
+
 	void ProcessActions(FVoxelRuntime& Runtime);
 	void ProcessAction(
 		FVoxelRuntime& Runtime,
@@ -88,6 +88,9 @@ public:
 	void CallCreate(FVoxelRuntime& Runtime) const;
 	void CallDestroy(FVoxelRuntime& Runtime) const;
 
+	// Chunks with gameplay relevant objects, eg collision, are created before purely visual ones
+	virtual bool IsGameplayRelevant() const { return false; }
+
 protected:
 	virtual void Create(FVoxelRuntime& Runtime) const {}
 	virtual void Destroy(FVoxelRuntime& Runtime) const {}
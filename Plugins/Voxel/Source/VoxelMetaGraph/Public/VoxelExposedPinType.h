@@ -17,6 +17,12 @@ struct VOXELMETAGRAPH_API FVoxelExposedPinType : public FVoxelVirtualStruct
 
 	FVoxelPinValue Compute(const FVoxelPinValue& Value, FVoxelRuntime& InRuntime) const;
 
+	// True if Compute uses runtime subsystems: graphs using this type cannot be shared between runtimes
+	virtual bool DependsOnRuntime() const
+	{
+		return false;
+	}
+
 protected:
 	virtual void ComputeImpl(FVoxelPinValue& OutValue, const FVoxelPinValue& Value) const VOXEL_PURE_VIRTUAL();
 
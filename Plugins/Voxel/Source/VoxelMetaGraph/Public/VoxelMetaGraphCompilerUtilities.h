@@ -43,6 +43,11 @@ public:
 	static void CheckOutputs(const FGraph& Graph);
 	static void ReplaceParameters(FGraph& Graph, const FVoxelMetaGraphVariableCollection& Variables, FVoxelRuntime* Runtime);
 
+	// Merge nodes with the same struct, properties & inputs
+	static void MergeIdenticalNodes(FGraph& Graph);
+	// Wrap subgraphs only depending on GetPosition2D in Query2D nodes
+	static void InsertQuery2DNodes(FGraph& Graph);
+
 	static void ReplaceCodeGenNodes(FGraph& Graph);
 	static bool ReplaceCodeGenNodesImpl(FGraph& Graph);
 
@@ -65,6 +70,14 @@ public:
 		TMap<const FPin*, FPin*>& OldToNewPins);
 
 private:
+	// Hash of the graph, the macros it uses & the variables. False if the compiled graph can't be cached
+	// OutObjects are the graphs & assets the key depends on
+	static bool GetCompileCacheKey(
+		const UVoxelMetaGraph& MetaGraph,
+		const FVoxelMetaGraphVariableCollection& Variables,
+		uint64& OutKey,
+		TArray<TWeakObjectPtr<const UObject>>& OutObjects);
+
 	static bool MakeDefaultValue(
 		const FVoxelPinType& Type,
 		const FVoxelPinValue& ExposedDefaultValue,
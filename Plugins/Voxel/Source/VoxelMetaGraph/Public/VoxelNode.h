@@ -454,6 +454,12 @@ public:
 	{
 		return false;
 	}
+	// True if the outputs only depend on the input pins and not on the query
+	// Chains of such nodes starting from GetPosition2D are evaluated once per column in 3D queries
+	virtual bool OnlyDependsOnInputs() const
+	{
+		return IsCodeGen();
+	}
 
 	enum class EExecType
 	{
@@ -477,6 +483,12 @@ public:
 		ensure(false);
 		return {};
 	}
+	// Conservative range of the outputs given the range of the inputs, one interval per register in pin order
+	// Used to skip evaluating codegen graphs whose output is known. Return false if unsupported
+	virtual bool ComputeIntervals(TConstVoxelArrayView<FFloatInterval> Inputs, TVoxelArrayView<FFloatInterval> Outputs) const
+	{
+		return false;
+	}
 
 	virtual void Initialize() {}
 	virtual void ReturnToPool();
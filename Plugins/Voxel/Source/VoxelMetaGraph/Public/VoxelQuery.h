@@ -231,4 +231,30 @@ struct VOXELMETAGRAPH_API FVoxelLODQueryData : public FVoxelQueryData
 	{
 		return LOD == Other.LOD;
 	}
+};
+
+// The caller only needs to know whether the output has a uniform sign, eg to skip empty marching cube chunks
+// The node queried directly can then return a constant with the same sign instead of the real values
+USTRUCT()
+struct VOXELMETAGRAPH_API FVoxelUniformSignQueryData : public FVoxelQueryData
+{
+	GENERATED_BODY()
+	GENERATED_VOXEL_QUERY_DATA_BODY()
+
+	// Callstack size of the caller, nodes deeper in the callstack must ignore this
+	int32 CallstackNum = 0;
+
+	bool IsDirectlyQueried(const FVoxelQuery& Query) const
+	{
+		return Query.Callstack.Num() == CallstackNum + 1;
+	}
+
+	uint64 GetHash() const
+	{
+		return FVoxelUtilities::MurmurHash(CallstackNum);
+	}
+	bool Identical(const FVoxelUniformSignQueryData& Other) const
+	{
+		return CallstackNum == Other.CallstackNum;
+	}
 };
\ No newline at end of file
@@ -49,16 +49,21 @@ public:
 
 	int32 Num() const
 	{
-		return Map.Num();
+		return Elements.Num();
 	}
 
 	ValueType* Find(const FHashedQuery& Query)
 	{
-		return Map.Find(&Query);
+		FElement* Element = Elements.Find(&Query);
+		return Element ? &Element->Value : nullptr;
 	}
 	ValueType& Add(const FHashedQuery& Query, const ValueType& Value = {})
 	{
-		return Map.Add(Queries.Add_GetRef(MakeUniqueCopy(Query)).Get(), Value);
+		TUniquePtr<FHashedQuery> OwnedQuery = MakeUniqueCopy(Query);
+		const FHashedQuery* Key = OwnedQuery.Get();
+
+		const FSetElementId ElementId = Elements.Add(FElement{ Key, Value, MoveTemp(OwnedQuery) });
+		return Elements[ElementId].Value;
 	}
 	
 	ValueType FindRef(const FHashedQuery& Query)
@@ -82,20 +87,39 @@ public:
 	
 	void Remove(const FHashedQuery& Query)
 	{
-		ensure(Map.Remove(&Query));
+		// Remove by id: Query might be the key owned by the element, which is freed along with it
+		const FSetElementId ElementId = Elements.FindId(&Query);
+		if (!ensure(ElementId.IsValidId()))
+		{
+			return;
+		}
+
+		Elements.Remove(ElementId);
 	}
 
-	FORCEINLINE auto begin() const -> decltype(auto) { return Map.begin(); }
-	FORCEINLINE auto end() const -> decltype(auto) { return Map.end(); }
+	FORCEINLINE auto begin() const -> decltype(auto) { return Elements.begin(); }
+	FORCEINLINE auto end() const -> decltype(auto) { return Elements.end(); }
 
 	auto CreateIterator() -> decltype(auto)
 	{
-		return Map.CreateIterator();
+		return Elements.CreateIterator();
 	}
 
 private:
-	struct FFuncs : public TDefaultMapKeyFuncs<const FHashedQuery*, ValueType, false>
+	struct FElement
 	{
+		const FHashedQuery* Key = nullptr;
+		ValueType Value;
+		// Owns Key, so that removing an element frees its query
+		TUniquePtr<FHashedQuery> OwnedQuery;
+	};
+
+	struct FFuncs : public BaseKeyFuncs<FElement, const FHashedQuery*, false>
+	{
+		FORCEINLINE static const FHashedQuery* GetSetKey(const FElement& Element)
+		{
+			return Element.Key;
+		}
 		FORCEINLINE static bool Matches(const FHashedQuery* A, const FHashedQuery* B)
 		{
 			checkVoxelSlow(A);
@@ -150,6 +174,5 @@ private:
 			return true;
 		}
 	};
-	TVoxelArray<TUniquePtr<FHashedQuery>> Queries;
-	TMap<const FHashedQuery*, ValueType, FDefaultSetAllocator, FFuncs> Map;
+	TSet<FElement, FFuncs> Elements;
 };
\ No newline at end of file
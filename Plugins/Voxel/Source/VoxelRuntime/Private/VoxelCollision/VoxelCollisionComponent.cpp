@@ -2,7 +2,12 @@
 
 #include "VoxelCollision/VoxelCollisionComponent.h"
 #include "VoxelCollision/VoxelTriangleMeshCollider.h"
+#include "VoxelCollision/VoxelHeightfieldCollider.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Physics/PhysicsFiltering.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+#include "Chaos/ImplicitObjectTransformed.h"
 
 void UVoxelCollisionComponent::SetCollider(const TSharedPtr<const FVoxelCollider>& NewCollider)
 {
@@ -73,6 +78,39 @@ bool UVoxelCollisionComponent::ShouldCreatePhysicsState() const
 	return Collider.IsValid();
 }
 
+void UVoxelCollisionComponent::OnCreatePhysicsState()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	const FVoxelHeightfieldCollider* HeightfieldCollider = Collider ? Collider->As<FVoxelHeightfieldCollider>() : nullptr;
+	if (!HeightfieldCollider)
+	{
+		Super::OnCreatePhysicsState();
+		return;
+	}
+
+	// Skip UPrimitiveComponent: heightfields can't be added to body setups
+	USceneComponent::OnCreatePhysicsState();
+
+	CreateHeightfieldPhysicsState(*HeightfieldCollider);
+}
+
+void UVoxelCollisionComponent::OnDestroyPhysicsState()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr)
+	{
+		const FPhysicsActorHandle& ActorHandle = BodyInstance.GetPhysicsActorHandle();
+		if (FPhysicsInterface::IsValid(ActorHandle))
+		{
+			PhysScene->RemoveFromComponentMaps(ActorHandle);
+		}
+	}
+
+	Super::OnDestroyPhysicsState();
+}
+
 FBoxSphereBounds UVoxelCollisionComponent::CalcBounds(const FTransform& LocalToWorld) const
 {
 	const FBox LocalBounds = Collider.IsValid() ? Collider->GetBounds() : FBox(FVector::ZeroVector, FVector::ZeroVector);
@@ -96,6 +134,101 @@ void UVoxelCollisionComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
 	}
 }
 
+void UVoxelCollisionComponent::CreateHeightfieldPhysicsState(const FVoxelHeightfieldCollider& HeightfieldCollider)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	// Adapted from ULandscapeHeightfieldCollisionComponent::OnCreatePhysicsState
+
+	const ECollisionEnabled::Type CollisionEnabled = BodyInstance.GetCollisionEnabled();
+
+	FPhysScene* PhysScene = GetWorld()->GetPhysicsScene();
+	if (!PhysScene ||
+		CollisionEnabled == ECollisionEnabled::NoCollision ||
+		!ensure(HeightfieldCollider.Heightfield))
+	{
+		return;
+	}
+
+	FActorCreationParams Params;
+	Params.InitialTM = GetComponentTransform();
+	Params.InitialTM.SetScale3D(FVector::OneVector);
+	Params.bQueryOnly = CollisionEnabled == ECollisionEnabled::QueryOnly;
+	Params.bStatic = true;
+	Params.Scene = PhysScene;
+
+	FPhysicsActorHandle PhysHandle;
+	FPhysicsInterface::CreateActor(Params, PhysHandle);
+	Chaos::FRigidBodyHandle_External& Body_External = PhysHandle->GetGameThreadAPI();
+
+	FCollisionFilterData QueryFilterData;
+	FCollisionFilterData SimFilterData;
+	CreateShapeFilterData(
+		BodyInstance.GetObjectType(),
+		FMaskFilter(0),
+		GetOwner() ? GetOwner()->GetUniqueID() : 0,
+		BodyInstance.GetResponseToChannels(),
+		GetUniqueID(),
+		0,
+		QueryFilterData,
+		SimFilterData,
+		true,
+		false,
+		true);
+
+	// Heightfield is used for both simple and complex collision
+	QueryFilterData.Word3 |= EPDF_SimpleCollision | EPDF_ComplexCollision;
+	SimFilterData.Word3 |= EPDF_SimpleCollision;
+
+	TArray<Chaos::FMaterialHandle> MaterialHandles;
+	for (const TWeakObjectPtr<UPhysicalMaterial>& PhysicalMaterial : HeightfieldCollider.PhysicalMaterials)
+	{
+		const UPhysicalMaterial* Material = PhysicalMaterial.IsValid() ? PhysicalMaterial.Get() : GEngine->DefaultPhysMaterial.Get();
+		MaterialHandles.Add(Material->GetPhysicsMaterial());
+	}
+	if (MaterialHandles.Num() == 0)
+	{
+		MaterialHandles.Add(GEngine->DefaultPhysMaterial->GetPhysicsMaterial());
+	}
+
+	TUniquePtr<Chaos::TImplicitObjectTransformed<Chaos::FReal, 3>> Geometry = MakeUnique<Chaos::TImplicitObjectTransformed<Chaos::FReal, 3>>(
+		Chaos::MakeSerializable(HeightfieldCollider.Heightfield),
+		Chaos::FRigidTransform3(HeightfieldCollider.Offset, FQuat::Identity));
+
+	TUniquePtr<Chaos::FPerShapeData> Shape = Chaos::FPerShapeData::CreatePerShapeData(0, Chaos::MakeSerializable(Geometry));
+	Shape->SetQueryData(QueryFilterData);
+	Shape->SetSimData(SimFilterData);
+	Shape->SetQueryEnabled(CollisionEnabledHasQuery(CollisionEnabled));
+	Shape->SetSimEnabled(CollisionEnabledHasPhysics(CollisionEnabled));
+	Shape->SetMaterials(MaterialHandles);
+
+	Body_External.SetGeometry(MoveTemp(Geometry));
+	Shape->UpdateShapeBounds(Chaos::FRigidTransform3(Body_External.X(), Body_External.R()));
+
+	Chaos::FShapesArray ShapeArray;
+	ShapeArray.Emplace(MoveTemp(Shape));
+	Body_External.SetShapesArray(MoveTemp(ShapeArray));
+
+	BodyInstance.PhysicsUserData = FPhysicsUserData(&BodyInstance);
+	BodyInstance.OwnerComponent = this;
+	BodyInstance.ActorHandle = PhysHandle;
+	Body_External.SetUserData(&BodyInstance.PhysicsUserData);
+
+	TArray<FPhysicsActorHandle> Actors;
+	Actors.Add(PhysHandle);
+
+	FPhysicsCommand::ExecuteWrite(PhysScene, [&]
+	{
+		PhysScene->AddActorsToScene_AssumesLocked(Actors, true);
+	});
+	PhysScene->AddToComponentMaps(this, PhysHandle);
+
+	if (BodyInstance.bNotifyRigidBodyCollision)
+	{
+		PhysScene->RegisterForCollisionEvents(this);
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -2,46 +2,40 @@
 
 #include "VoxelCollision/VoxelCollisionComponentPool.h"
 #include "VoxelCollision/VoxelCollisionComponent.h"
-#include "VoxelComponentSubsystem.h"
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, int32, GVoxelCollisionComponentPoolSize, 32,
+	"voxel.collision.PoolSize",
+	"Number of collision components created ahead of time and kept ready in the pool");
 
 DEFINE_VOXEL_SUBSYSTEM(FVoxelCollisionComponentPool);
 
-UVoxelCollisionComponent* FVoxelCollisionComponentPool::CreateComponent(const FVector3d& Position)
+void FVoxelCollisionComponentPool::Tick()
 {
 	VOXEL_FUNCTION_COUNTER();
-	check(IsInGameThread());
 
-	UVoxelCollisionComponent* NewMesh = nullptr;
-	while (MeshPool.Num() > 0 && !NewMesh)
-	{
-		NewMesh = MeshPool.Pop(false).Get();
-		ensure(NewMesh != nullptr);
-	}
+	Super::Tick();
 
-	FVoxelComponentSubsystem& ComponentSubsystem = GetSubsystem<FVoxelComponentSubsystem>();
+	// Physics states & scene proxies are only created once a collider is set
+	GetSubsystem<FVoxelComponentSubsystem>().TickPool(
+		MeshPool,
+		UVoxelCollisionComponent::StaticClass(),
+		GVoxelCollisionComponentPoolSize,
+		true);
+}
 
-	if (!NewMesh)
-	{
-		NewMesh = ComponentSubsystem.CreateComponent<UVoxelCollisionComponent>();
-		if (!ensure(NewMesh))
-		{
-			return nullptr;
-		}
-		
-		ComponentSubsystem.SetupSceneComponent(*NewMesh);
-
-		NewMesh->RegisterComponent();
-	}
-	
-	ComponentSubsystem.SetComponentPosition(*NewMesh, Position);
+UVoxelCollisionComponent* FVoxelCollisionComponentPool::CreateComponent(const FVector3d& Position)
+{
+	VOXEL_FUNCTION_COUNTER();
 
-	return NewMesh;
+	return CastChecked<UVoxelCollisionComponent>(
+		GetSubsystem<FVoxelComponentSubsystem>().CreatePooledComponent(MeshPool, UVoxelCollisionComponent::StaticClass(), Position),
+		ECastCheckedType::NullAllowed);
 }
 
 void FVoxelCollisionComponentPool::DestroyComponent(UVoxelCollisionComponent* Mesh)
 {
 	VOXEL_FUNCTION_COUNTER();
-	check(IsInGameThread());
 
 	if (!ensure(Mesh))
 	{
@@ -50,5 +44,5 @@ void FVoxelCollisionComponentPool::DestroyComponent(UVoxelCollisionComponent* Me
 
 	Mesh->SetCollider({});
 
-	MeshPool.Add(Mesh);
+	GetSubsystem<FVoxelComponentSubsystem>().DestroyPooledComponent(MeshPool, Mesh);
 }
\ No newline at end of file
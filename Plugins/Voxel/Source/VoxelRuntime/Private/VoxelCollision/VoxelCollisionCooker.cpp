@@ -2,8 +2,505 @@
 
 #include "VoxelCollision/VoxelCollisionCooker.h"
 #include "VoxelCollision/VoxelTriangleMeshCollider.h"
+#include "VoxelCollision/VoxelHeightfieldCollider.h"
 #include "Chaos/CollisionConvexMesh.h"
 
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, int32, GVoxelCollisionCookCacheSize, 256,
+	"voxel.collision.CookCacheSize",
+	"Number of cooked triangle meshes and heightfields kept alive to be reused by chunks regenerated with the same geometry");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, int32, GVoxelCollisionNumCookThreads, 2,
+	"voxel.collision.NumCookThreads",
+	"Max number of background tasks cooking collision at the same time");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, bool, GVoxelCollisionHeightfields, true,
+	"voxel.collision.Heightfields",
+	"If true, chunks without overhangs will use heightfields instead of triangle meshes");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, int32, GVoxelCollisionCookBatchSize, 16384,
+	"voxel.collision.CookBatchSize",
+	"Cooks are batched together until they reach this number of triangles");
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelCollisionCookPriority::SetPositions(TArray<FVector>&& NewPositions)
+{
+	VOXEL_SCOPE_LOCK(CriticalSection);
+	Positions = MoveTemp(NewPositions);
+}
+
+double FVoxelCollisionCookPriority::GetSquaredDistance(const FBox& Bounds) const
+{
+	VOXEL_SCOPE_LOCK(CriticalSection);
+
+	double Distance = MAX_dbl;
+	for (const FVector& Position : Positions)
+	{
+		Distance = FMath::Min(Distance, Bounds.ComputeSquaredDistanceToPoint(Position));
+	}
+	return Distance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+class TVoxelCollisionCookCache
+{
+public:
+	TSharedPtr<T> Find(const uint64 Hash)
+	{
+		VOXEL_SCOPE_LOCK(CriticalSection);
+
+		const TWeakPtr<T>* WeakObject = WeakObjects.Find(Hash);
+		if (!WeakObject)
+		{
+			return nullptr;
+		}
+
+		const TSharedPtr<T> Object = WeakObject->Pin();
+		if (!Object)
+		{
+			WeakObjects.Remove(Hash);
+		}
+		return Object;
+	}
+	void Add(const uint64 Hash, const TSharedRef<T>& Object)
+	{
+		VOXEL_SCOPE_LOCK(CriticalSection);
+
+		WeakObjects.Add(Hash, Object);
+
+		// Keep the most recent cooks alive, in case their chunk is destroyed before being regenerated
+		RecentObjects.Add(Object);
+		if (RecentObjects.Num() > FMath::Max(GVoxelCollisionCookCacheSize, 0))
+		{
+			RecentObjects.RemoveAt(0, RecentObjects.Num() - FMath::Max(GVoxelCollisionCookCacheSize, 0), false);
+		}
+
+		if (WeakObjects.Num() > 4 * FMath::Max(GVoxelCollisionCookCacheSize, 64))
+		{
+			VOXEL_SCOPE_COUNTER("Cleanup");
+			for (auto It = WeakObjects.CreateIterator(); It; ++It)
+			{
+				if (!It.Value().IsValid())
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+	}
+
+private:
+	FVoxelCriticalSection CriticalSection;
+	TMap<uint64, TWeakPtr<T>> WeakObjects;
+	TArray<TSharedPtr<T>> RecentObjects;
+};
+
+TVoxelCollisionCookCache<Chaos::FTriangleMeshImplicitObject> GVoxelCollisionCookCache;
+TVoxelCollisionCookCache<Chaos::FHeightField> GVoxelCollisionHeightfieldCookCache;
+
+uint64 HashCollisionCookInputs(
+	const TConstVoxelArrayView<int32> Indices,
+	const TConstVoxelArrayView<FVector3f> Vertices,
+	const TConstVoxelArrayView<uint16> FaceMaterials,
+	const uint64 Seed)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	uint64 Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Indices.GetData()), Indices.Num() * Indices.GetTypeSize(), Seed);
+	Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Vertices.GetData()), Vertices.Num() * Vertices.GetTypeSize(), Hash);
+	Hash = CityHash64WithSeed(reinterpret_cast<const char*>(FaceMaterials.GetData()), FaceMaterials.Num() * FaceMaterials.GetTypeSize(), Hash);
+	return Hash;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+class FVoxelCollisionCookQueue
+{
+public:
+	struct FTask
+	{
+		FBox Bounds;
+		// Owned by the collision processor: the task is cancelled once its runtime is destroyed
+		TWeakPtr<const FVoxelCollisionCookPriority> Priority;
+		TVoxelArray<int32> Indices;
+		TVoxelArray<FVector3f> Vertices;
+		TVoxelArray<uint16> FaceMaterials;
+		TArray<TWeakObjectPtr<UPhysicalMaterial>> PhysicalMaterials;
+		float HeightfieldCellSize = 0.f;
+		TFunction<void(const TSharedPtr<FVoxelCollider>&)> OnComplete;
+
+		double Distance = 0.;
+
+		bool IsCancelled() const
+		{
+			return !Priority.IsValid();
+		}
+	};
+
+	void Enqueue(TUniquePtr<FTask> Task)
+	{
+		VOXEL_SCOPE_LOCK(CriticalSection);
+
+		if (bIsExiting)
+		{
+			return;
+		}
+
+		Tasks.Add(MoveTemp(Task));
+
+		if (NumWorkers >= FMath::Max(GVoxelCollisionNumCookThreads, 1))
+		{
+			return;
+		}
+		NumWorkers++;
+
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [this]
+		{
+			Work();
+		});
+	}
+
+	void Shutdown()
+	{
+		VOXEL_FUNCTION_COUNTER();
+
+		{
+			VOXEL_SCOPE_LOCK(CriticalSection);
+			bIsExiting = true;
+			Tasks.Reset();
+		}
+
+		// Workers reference this queue, wait for them to return before it is destroyed
+		while (FTaskGraphInterface::IsRunning())
+		{
+			{
+				VOXEL_SCOPE_LOCK(CriticalSection);
+				if (NumWorkers == 0)
+				{
+					break;
+				}
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}
+
+private:
+	FVoxelCriticalSection CriticalSection;
+	TArray<TUniquePtr<FTask>> Tasks;
+	int32 NumWorkers = 0;
+	bool bIsExiting = false;
+
+	void Work()
+	{
+		VOXEL_FUNCTION_COUNTER();
+
+		while (true)
+		{
+			TArray<TUniquePtr<FTask>> Batch;
+			{
+				VOXEL_SCOPE_LOCK(CriticalSection);
+
+				if (Tasks.Num() == 0)
+				{
+					NumWorkers--;
+					return;
+				}
+
+				PopBatch_AssumeLocked(Batch);
+			}
+
+			for (const TUniquePtr<FTask>& Task : Batch)
+			{
+				if (Task->IsCancelled())
+				{
+					Task->OnComplete(nullptr);
+					continue;
+				}
+
+				Task->OnComplete(Cook(*Task));
+			}
+		}
+	}
+	static TSharedPtr<FVoxelCollider> Cook(FTask& Task)
+	{
+		if (GVoxelCollisionHeightfields &&
+			Task.HeightfieldCellSize > 0.f)
+		{
+			if (const TSharedPtr<FVoxelHeightfieldCollider> Collider = FVoxelCollisionCooker::CookHeightfield(
+				Task.Indices,
+				Task.Vertices,
+				Task.FaceMaterials,
+				Task.HeightfieldCellSize))
+			{
+				Collider->PhysicalMaterials = MoveTemp(Task.PhysicalMaterials);
+				return Collider;
+			}
+		}
+
+		const TSharedPtr<FVoxelTriangleMeshCollider> Collider = FVoxelCollisionCooker::CookTriangleMesh(
+			Task.Indices,
+			Task.Vertices,
+			Task.FaceMaterials);
+
+		if (Collider)
+		{
+			Collider->PhysicalMaterials = MoveTemp(Task.PhysicalMaterials);
+		}
+		return Collider;
+	}
+	void PopBatch_AssumeLocked(TArray<TUniquePtr<FTask>>& OutBatch)
+	{
+		VOXEL_FUNCTION_COUNTER();
+
+		// Distances are recomputed every time as the priority positions move
+		for (const TUniquePtr<FTask>& Task : Tasks)
+		{
+			const TSharedPtr<const FVoxelCollisionCookPriority> Priority = Task->Priority.Pin();
+
+			// Cancelled tasks are popped first to release their data
+			Task->Distance = Priority ? Priority->GetSquaredDistance(Task->Bounds) : -1.;
+		}
+
+		Tasks.Sort([](const TUniquePtr<FTask>& A, const TUniquePtr<FTask>& B)
+		{
+			// Closest last, to pop them
+			return A->Distance > B->Distance;
+		});
+
+		int32 NumTriangles = 0;
+		while (
+			Tasks.Num() > 0 &&
+			(OutBatch.Num() == 0 || NumTriangles + Tasks.Last()->Indices.Num() / 3 <= GVoxelCollisionCookBatchSize))
+		{
+			NumTriangles += Tasks.Last()->Indices.Num() / 3;
+			OutBatch.Add(Tasks.Pop(false));
+		}
+	}
+};
+
+FVoxelCollisionCookQueue GVoxelCollisionCookQueue;
+
+VOXEL_RUN_ON_STARTUP_GAME(RegisterCollisionCookQueueShutdown)
+{
+	FCoreDelegates::OnPreExit.AddLambda([]
+	{
+		GVoxelCollisionCookQueue.Shutdown();
+	});
+	GOnVoxelModuleUnloaded.AddLambda([]
+	{
+		GVoxelCollisionCookQueue.Shutdown();
+	});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelCollisionCooker::CookMeshAsync(
+	const FBox& Bounds,
+	const TSharedRef<const FVoxelCollisionCookPriority>& Priority,
+	TVoxelArray<int32>&& Indices,
+	TVoxelArray<FVector3f>&& Vertices,
+	TVoxelArray<uint16>&& FaceMaterials,
+	TArray<TWeakObjectPtr<UPhysicalMaterial>>&& PhysicalMaterials,
+	const float HeightfieldCellSize,
+	TFunction<void(const TSharedPtr<FVoxelCollider>&)>&& OnComplete)
+{
+	TUniquePtr<FVoxelCollisionCookQueue::FTask> Task = MakeUnique<FVoxelCollisionCookQueue::FTask>();
+	Task->Bounds = Bounds;
+	Task->Priority = Priority;
+	Task->Indices = MoveTemp(Indices);
+	Task->Vertices = MoveTemp(Vertices);
+	Task->FaceMaterials = MoveTemp(FaceMaterials);
+	Task->PhysicalMaterials = MoveTemp(PhysicalMaterials);
+	Task->HeightfieldCellSize = HeightfieldCellSize;
+	Task->OnComplete = MoveTemp(OnComplete);
+
+	GVoxelCollisionCookQueue.Enqueue(MoveTemp(Task));
+}
+
+TSharedPtr<FVoxelHeightfieldCollider> FVoxelCollisionCooker::CookHeightfield(
+	const TConstVoxelArrayView<int32> Indices,
+	const TConstVoxelArrayView<FVector3f> Vertices,
+	const TConstVoxelArrayView<uint16> FaceMaterials,
+	const float CellSize)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (Indices.Num() == 0 ||
+		!ensure(Indices.Num() % 3 == 0) ||
+		!ensure(CellSize > 0.f))
+	{
+		return nullptr;
+	}
+
+	const int32 NumTriangles = Indices.Num() / 3;
+
+	for (const uint16 FaceMaterial : FaceMaterials)
+	{
+		if (FaceMaterial > MAX_uint8)
+		{
+			// Heightfields store materials as uint8
+			return nullptr;
+		}
+	}
+
+	const FBox3f VertexBounds(Vertices.GetData(), Vertices.Num());
+
+	// Only sample the grid points inside the mesh, with some tolerance for points on its border
+	const int32 MinX = FMath::CeilToInt(VertexBounds.Min.X / CellSize - 0.01f);
+	const int32 MinY = FMath::CeilToInt(VertexBounds.Min.Y / CellSize - 0.01f);
+	const int32 MaxX = FMath::FloorToInt(VertexBounds.Max.X / CellSize + 0.01f);
+	const int32 MaxY = FMath::FloorToInt(VertexBounds.Max.Y / CellSize + 0.01f);
+
+	const int32 NumCols = MaxX - MinX + 1;
+	const int32 NumRows = MaxY - MinY + 1;
+	if (NumCols < 2 ||
+		NumRows < 2)
+	{
+		return nullptr;
+	}
+
+	const uint64 Hash = HashCollisionCookInputs(Indices, Vertices, FaceMaterials, ReinterpretCastRef<uint32>(CellSize));
+
+	if (const TSharedPtr<Chaos::FHeightField> CachedHeightfield = GVoxelCollisionHeightfieldCookCache.Find(Hash))
+	{
+		const TSharedRef<FVoxelHeightfieldCollider> Collider = MakeShared<FVoxelHeightfieldCollider>();
+		Collider->Offset = FVector(MinX * CellSize, MinY * CellSize, 0.f);
+		Collider->Bounds = FBox(VertexBounds);
+		Collider->Heightfield = CachedHeightfield;
+		return Collider;
+	}
+
+	TArray<Chaos::FReal> Heights;
+	TVoxelArray<int32> PointTriangles;
+	FVoxelUtilities::SetNumFast(Heights, NumRows * NumCols);
+	FVoxelUtilities::SetNumFast(PointTriangles, NumRows * NumCols);
+	FVoxelUtilities::SetAll(PointTriangles, -1);
+
+	{
+		VOXEL_SCOPE_COUNTER("Rasterize");
+
+		for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++)
+		{
+			const FVector3f A = Vertices[Indices[3 * Triangle + 0]] / CellSize - FVector3f(MinX, MinY, 0.f);
+			const FVector3f B = Vertices[Indices[3 * Triangle + 1]] / CellSize - FVector3f(MinX, MinY, 0.f);
+			const FVector3f C = Vertices[Indices[3 * Triangle + 2]] / CellSize - FVector3f(MinX, MinY, 0.f);
+
+			if (A == B || B == C || A == C)
+			{
+				continue;
+			}
+
+			// Vertical or downward faces can't be represented by a heightfield
+			if (FVoxelUtilities::GetTriangleNormal(A, B, C).Z < 0.01f)
+			{
+				return nullptr;
+			}
+
+			const float Area = (B.X - A.X) * (C.Y - A.Y) - (B.Y - A.Y) * (C.X - A.X);
+			if (FMath::Abs(Area) < KINDA_SMALL_NUMBER)
+			{
+				continue;
+			}
+
+			const int32 StartX = FMath::Max(FMath::CeilToInt(FMath::Min3(A.X, B.X, C.X) - 0.01f), 0);
+			const int32 StartY = FMath::Max(FMath::CeilToInt(FMath::Min3(A.Y, B.Y, C.Y) - 0.01f), 0);
+			const int32 EndX = FMath::Min(FMath::FloorToInt(FMath::Max3(A.X, B.X, C.X) + 0.01f), NumCols - 1);
+			const int32 EndY = FMath::Min(FMath::FloorToInt(FMath::Max3(A.Y, B.Y, C.Y) + 0.01f), NumRows - 1);
+
+			for (int32 Y = StartY; Y <= EndY; Y++)
+			{
+				for (int32 X = StartX; X <= EndX; X++)
+				{
+					const float U = ((B.X - X) * (C.Y - Y) - (B.Y - Y) * (C.X - X)) / Area;
+					const float V = ((C.X - X) * (A.Y - Y) - (C.Y - Y) * (A.X - X)) / Area;
+					const float W = 1.f - U - V;
+
+					if (U < -0.001f ||
+						V < -0.001f ||
+						W < -0.001f)
+					{
+						continue;
+					}
+
+					const int32 Index = Y * NumCols + X;
+					const Chaos::FReal Height = (U * A.Z + V * B.Z + W * C.Z) * CellSize;
+
+					if (PointTriangles[Index] != -1)
+					{
+						// Points on shared edges are sampled twice, anything else is an overhang
+						if (!FMath::IsNearlyEqual(Heights[Index], Height, CellSize * 0.01))
+						{
+							return nullptr;
+						}
+						continue;
+					}
+
+					Heights[Index] = Height;
+					PointTriangles[Index] = Triangle;
+				}
+			}
+		}
+	}
+
+	for (const int32 PointTriangle : PointTriangles)
+	{
+		if (PointTriangle == -1)
+		{
+			// Hole in the mesh, eg the surface leaves the chunk through its top or bottom
+			return nullptr;
+		}
+	}
+
+	TArray<uint8> MaterialIndices;
+	if (FaceMaterials.Num() == 0)
+	{
+		MaterialIndices.Add(0);
+	}
+	else
+	{
+		// One material per cell, taken from its first corner
+		MaterialIndices.Reserve((NumRows - 1) * (NumCols - 1));
+		for (int32 Y = 0; Y < NumRows - 1; Y++)
+		{
+			for (int32 X = 0; X < NumCols - 1; X++)
+			{
+				MaterialIndices.Add(FaceMaterials[PointTriangles[Y * NumCols + X]]);
+			}
+		}
+	}
+
+	const TSharedRef<FVoxelHeightfieldCollider> Collider = MakeShared<FVoxelHeightfieldCollider>();
+	Collider->Offset = FVector(MinX * CellSize, MinY * CellSize, 0.f);
+	Collider->Bounds = FBox(VertexBounds);
+
+	{
+		VOXEL_SCOPE_COUNTER("Cook");
+		Collider->Heightfield = MakeShared<Chaos::FHeightField>(
+			MoveTemp(Heights),
+			MoveTemp(MaterialIndices),
+			NumRows,
+			NumCols,
+			Chaos::FVec3(CellSize, CellSize, 1.f));
+	}
+
+	GVoxelCollisionHeightfieldCookCache.Add(Hash, Collider->Heightfield.ToSharedRef());
+
+	return Collider;
+}
+
 TSharedPtr<FVoxelTriangleMeshCollider> FVoxelCollisionCooker::CookTriangleMesh(
 	const TConstVoxelArrayView<int32> Indices,
 	const TConstVoxelArrayView<FVector3f> Vertices,
@@ -17,6 +514,16 @@ TSharedPtr<FVoxelTriangleMeshCollider> FVoxelCollisionCooker::CookTriangleMesh(
 		return nullptr;
 	}
 
+	const uint64 Hash = HashCollisionCookInputs(Indices, Vertices, FaceMaterials, 0);
+
+	if (const TSharedPtr<Chaos::FTriangleMeshImplicitObject> CachedTriangleMesh = GVoxelCollisionCookCache.Find(Hash))
+	{
+		const TSharedRef<FVoxelTriangleMeshCollider> Collider = MakeShared<FVoxelTriangleMeshCollider>();
+		Collider->TriangleMeshes.Add(CachedTriangleMesh);
+		Collider->Bounds = FBox(FBox3f(Vertices.GetData(), Vertices.Num()));
+		return Collider;
+	}
+
 	Chaos::TParticles<Chaos::FRealSingle, 3> Particles;
 	Particles.AddParticles(Vertices.Num());
 	for (int32 Index = 0; Index < Vertices.Num(); Index++)
@@ -77,6 +584,7 @@ TSharedPtr<FVoxelTriangleMeshCollider> FVoxelCollisionCooker::CookTriangleMesh(
 	}
 
 	Collider->TriangleMeshes.Add(TriangleMesh);
+	GVoxelCollisionCookCache.Add(Hash, TriangleMesh.ToSharedRef());
 
 	{
 		VOXEL_SCOPE_COUNTER("Compute bounds");
@@ -3,10 +3,46 @@
 #include "VoxelCollision/VoxelCollisionProcessor.h"
 #include "VoxelCollision/VoxelCollisionComponent.h"
 #include "VoxelCollision/VoxelCollisionComponentPool.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
 
 DEFINE_UNIQUE_VOXEL_ID(FVoxelCollisionProcessorId);
 DEFINE_VOXEL_SUBSYSTEM(FVoxelCollisionProcessor);
 
+void FVoxelCollisionProcessor::Tick()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	Super::Tick();
+
+	TArray<FVector> Positions;
+
+	FVector CameraPosition;
+	if (FVoxelGameUtilities::GetCameraView(GetWorld(), CameraPosition))
+	{
+		Positions.Add(WorldToLocal().TransformPosition(CameraPosition));
+	}
+
+	// Local players and simulated pawns are the physics bodies most likely to touch the terrain
+	for (TActorIterator<APawn> It(GetWorld()); It; ++It)
+	{
+		const UPrimitiveComponent* RootComponent = Cast<UPrimitiveComponent>(It->GetRootComponent());
+		if (!It->IsLocallyControlled() &&
+			!(RootComponent && RootComponent->IsSimulatingPhysics()))
+		{
+			continue;
+		}
+
+		Positions.Add(WorldToLocal().TransformPosition(It->GetActorLocation()));
+	}
+
+	CookPriority->SetPositions(MoveTemp(Positions));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 FVoxelCollisionProcessorId FVoxelCollisionProcessor::CreateCollision(
 	const FVector3d& Position,
 	const FBodyInstance& BodyInstance,
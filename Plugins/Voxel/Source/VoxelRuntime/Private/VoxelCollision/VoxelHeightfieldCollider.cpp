@@ -0,0 +1,65 @@
+﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
+
+#include "VoxelCollision/VoxelHeightfieldCollider.h"
+#include "VoxelCollision/VoxelTriangleMeshCollider.h"
+
+int64 FVoxelHeightfieldCollider::GetAllocatedSize() const
+{
+	int64 Result = 0;
+
+	if (Heightfield)
+	{
+		// Heights are quantized to 16 bits, materials are stored per cell
+		Result += Heightfield->GetNumRows() * Heightfield->GetNumCols() * sizeof(uint16);
+		Result += (Heightfield->GetNumRows() - 1) * (Heightfield->GetNumCols() - 1) * sizeof(uint8);
+	}
+
+	return Result;
+}
+
+TSharedPtr<IVoxelColliderRenderData> FVoxelHeightfieldCollider::GetRenderData() const
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (!ensure(Heightfield))
+	{
+		return nullptr;
+	}
+
+	const int32 NumRows = Heightfield->GetNumRows();
+	const int32 NumCols = Heightfield->GetNumCols();
+
+	const auto GetPoint = [&](const int32 Row, const int32 Col)
+	{
+		return FVector3f(Offset + Heightfield->GetPointScaled(Row * NumCols + Col));
+	};
+
+	TVoxelArray<FVector3f> Vertices;
+	Vertices.Reserve(6 * (NumRows - 1) * (NumCols - 1));
+
+	for (int32 Row = 0; Row < NumRows - 1; Row++)
+	{
+		for (int32 Col = 0; Col < NumCols - 1; Col++)
+		{
+			const FVector3f P00 = GetPoint(Row, Col);
+			const FVector3f P01 = GetPoint(Row, Col + 1);
+			const FVector3f P10 = GetPoint(Row + 1, Col);
+			const FVector3f P11 = GetPoint(Row + 1, Col + 1);
+
+			Vertices.Add(P00);
+			Vertices.Add(P11);
+			Vertices.Add(P10);
+
+			Vertices.Add(P00);
+			Vertices.Add(P01);
+			Vertices.Add(P11);
+		}
+	}
+
+	return MakeShared<FVoxelTriangleMeshCollider_RenderData>(MoveTemp(Vertices));
+}
+
+TArray<TWeakObjectPtr<UPhysicalMaterial>> FVoxelHeightfieldCollider::GetPhysicalMaterials() const
+{
+	return PhysicalMaterials;
+}
@@ -57,7 +57,6 @@ FVoxelTriangleMeshCollider_RenderData::FVoxelTriangleMeshCollider_RenderData(con
 {
 	VOXEL_FUNCTION_COUNTER();
 
-	TVoxelArray<uint32> Indices;
 	TVoxelArray<FVector3f> Vertices;
 	for (const TSharedPtr<Chaos::FTriangleMeshImplicitObject>& TriangleMesh : Collider.TriangleMeshes)
 	{
@@ -65,13 +64,8 @@ FVoxelTriangleMeshCollider_RenderData::FVoxelTriangleMeshCollider_RenderData(con
 		{
 			for (const auto& Element : Elements)
 			{
-				Indices.Add(Vertices.Num());
 				Vertices.Add(TriangleMesh->Particles().X(Element[0]));
-				
-				Indices.Add(Vertices.Num());
 				Vertices.Add(TriangleMesh->Particles().X(Element[1]));
-
-				Indices.Add(Vertices.Num());
 				Vertices.Add(TriangleMesh->Particles().X(Element[2]));
 			}
 		};
@@ -86,6 +80,35 @@ FVoxelTriangleMeshCollider_RenderData::FVoxelTriangleMeshCollider_RenderData(con
 		}
 	}
 
+	Initialize(Vertices);
+}
+
+FVoxelTriangleMeshCollider_RenderData::FVoxelTriangleMeshCollider_RenderData(TVoxelArray<FVector3f>&& Vertices)
+{
+	Initialize(Vertices);
+}
+
+FVoxelTriangleMeshCollider_RenderData::~FVoxelTriangleMeshCollider_RenderData()
+{
+	IndexBuffer.ReleaseResource();
+	PositionVertexBuffer.ReleaseResource();
+	StaticMeshVertexBuffer.ReleaseResource();
+	ColorVertexBuffer.ReleaseResource();
+	VertexFactory->ReleaseResource();
+}
+
+void FVoxelTriangleMeshCollider_RenderData::Initialize(const TVoxelArray<FVector3f>& Vertices)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(Vertices.Num() % 3 == 0);
+
+	TVoxelArray<uint32> Indices;
+	FVoxelUtilities::SetNumFast(Indices, Vertices.Num());
+	for (int32 Index = 0; Index < Vertices.Num(); Index++)
+	{
+		Indices[Index] = Index;
+	}
+
 	IndexBuffer.SetIndices(Indices, EIndexBufferStride::Force32Bit);
 	PositionVertexBuffer.Init(Vertices.Num(), false);
 	StaticMeshVertexBuffer.Init(Vertices.Num(), 1, false);
@@ -130,15 +153,6 @@ FVoxelTriangleMeshCollider_RenderData::FVoxelTriangleMeshCollider_RenderData(con
 	VertexFactory->InitResource();
 }
 
-FVoxelTriangleMeshCollider_RenderData::~FVoxelTriangleMeshCollider_RenderData()
-{
-	IndexBuffer.ReleaseResource();
-	PositionVertexBuffer.ReleaseResource();
-	StaticMeshVertexBuffer.ReleaseResource();
-	ColorVertexBuffer.ReleaseResource();
-	VertexFactory->ReleaseResource();
-}
-
 void FVoxelTriangleMeshCollider_RenderData::Draw_RenderThread(const FPrimitiveSceneProxy& Proxy, FMeshBatch& MeshBatch)
 {
 	MeshBatch.Type = PT_TriangleList;
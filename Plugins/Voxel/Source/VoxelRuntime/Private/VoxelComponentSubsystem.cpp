@@ -2,6 +2,16 @@
 
 #include "VoxelComponentSubsystem.h"
 
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, float, GVoxelComponentPoolBudget, 1.f,
+	"voxel.component.PoolBudget",
+	"Time in milliseconds each component pool can spend every frame creating & registering components ahead of time");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, float, GVoxelComponentPoolShrinkDelay, 10.f,
+	"voxel.component.PoolShrinkDelay",
+	"Component pools shrink once their size exceeds the peak demand of the last PoolShrinkDelay seconds");
+
 DEFINE_VOXEL_SUBSYSTEM(FVoxelComponentSubsystem);
 
 bool FVoxelComponentSubsystem::bDisableModify = false;
@@ -99,4 +109,124 @@ void FVoxelComponentSubsystem::SetComponentPosition(USceneComponent& Component,
 	Component.SetRelativeRotation_Direct(FRotator::ZeroRotator);
 	Component.SetRelativeScale3D_Direct(FVector::OneVector);
 	Component.UpdateComponentToWorld(EUpdateTransformFlags::None, ETeleportType::TeleportPhysics);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void FVoxelComponentSubsystem::TickPool(FComponentPool& Pool, const UClass* Class, const int32 PoolSize, const bool bPrewarm)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	const double Time = FPlatformTime::Seconds();
+	if (Time > Pool.PeakDemandResetTime)
+	{
+		Pool.PeakDemand = Pool.NumInUse;
+		Pool.PeakDemandResetTime = Time + GVoxelComponentPoolShrinkDelay;
+	}
+
+	Pool.Components.RemoveAllSwap([](const TWeakObjectPtr<USceneComponent>& Component)
+	{
+		return !Component.IsValid();
+	});
+
+	// Keep enough components to serve the recent peak demand again without creating any
+	const int32 TargetPoolSize = bPrewarm ? FMath::Max(PoolSize, Pool.PeakDemand - Pool.NumInUse) : 0;
+
+	if (Pool.Components.Num() > TargetPoolSize)
+	{
+		VOXEL_SCOPE_COUNTER("Shrink");
+
+		// Shrink gradually, demand might come back
+		const int32 NumToDestroy = FMath::Max(1, (Pool.Components.Num() - TargetPoolSize) / 16);
+		for (int32 Index = 0; Index < NumToDestroy; Index++)
+		{
+			DestroyComponent(Pool.Components.Pop(false).Get());
+		}
+		return;
+	}
+
+	if (Pool.Components.Num() == TargetPoolSize ||
+		!GetRootComponent())
+	{
+		return;
+	}
+
+	VOXEL_SCOPE_COUNTER("Prewarm");
+
+	const double EndTime = Time + GVoxelComponentPoolBudget / 1000.;
+	while (
+		Pool.Components.Num() < TargetPoolSize &&
+		FPlatformTime::Seconds() < EndTime)
+	{
+		USceneComponent* Component = CreateNewPooledComponent(Class);
+		if (!ensure(Component))
+		{
+			return;
+		}
+		Pool.Components.Add(Component);
+	}
+}
+
+USceneComponent* FVoxelComponentSubsystem::CreatePooledComponent(FComponentPool& Pool, const UClass* Class, const FVector3d& Position)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInGameThread());
+
+	USceneComponent* Component = nullptr;
+	while (Pool.Components.Num() > 0 && !Component)
+	{
+		Component = Pool.Components.Pop(false).Get();
+		ensure(Component != nullptr);
+	}
+
+	if (!Component)
+	{
+		// Pool is empty, TickPool will refill it
+		Component = CreateNewPooledComponent(Class);
+		if (!ensure(Component))
+		{
+			return nullptr;
+		}
+	}
+
+	SetComponentPosition(*Component, Position);
+
+	Pool.NumInUse++;
+	Pool.PeakDemand = FMath::Max(Pool.PeakDemand, Pool.NumInUse);
+
+	return Component;
+}
+
+void FVoxelComponentSubsystem::DestroyPooledComponent(FComponentPool& Pool, USceneComponent* Component)
+{
+	VOXEL_FUNCTION_COUNTER();
+	check(IsInGameThread());
+
+	if (!ensure(Component))
+	{
+		return;
+	}
+
+	Pool.Components.Add(Component);
+
+	Pool.NumInUse--;
+	ensure(Pool.NumInUse >= 0);
+}
+
+USceneComponent* FVoxelComponentSubsystem::CreateNewPooledComponent(const UClass* Class)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	USceneComponent* Component = Cast<USceneComponent>(CreateComponent(Class));
+	if (!ensure(Component))
+	{
+		return nullptr;
+	}
+
+	SetupSceneComponent(*Component);
+	Component->RegisterComponent();
+
+	return Component;
 }
\ No newline at end of file
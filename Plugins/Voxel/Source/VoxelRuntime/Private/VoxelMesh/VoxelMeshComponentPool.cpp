@@ -2,46 +2,41 @@
 
 #include "VoxelMesh/VoxelMeshComponentPool.h"
 #include "VoxelMesh/VoxelMeshComponent.h"
-#include "VoxelComponentSubsystem.h"
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, int32, GVoxelMeshComponentPoolSize, 32,
+	"voxel.mesh.PoolSize",
+	"Number of mesh components created ahead of time and kept ready in the pool");
 
 DEFINE_VOXEL_SUBSYSTEM(FVoxelMeshComponentPool);
 
-UVoxelMeshComponent* FVoxelMeshComponentPool::CreateMesh(const FVector3d& Position)
+void FVoxelMeshComponentPool::Tick()
 {
 	VOXEL_FUNCTION_COUNTER();
-	check(IsInGameThread());
 
-	UVoxelMeshComponent* NewMesh = nullptr;
-	while (MeshPool.Num() > 0 && !NewMesh)
-	{
-		NewMesh = MeshPool.Pop(false).Get();
-		ensure(NewMesh != nullptr);
-	}
+	Super::Tick();
 
-	FVoxelComponentSubsystem& ComponentSubsystem = GetSubsystem<FVoxelComponentSubsystem>();
+	// Empty mesh components have a render state but no scene proxy, and never have a physics state
+	// Dedicated servers don't render, so they only create mesh components on demand
+	GetSubsystem<FVoxelComponentSubsystem>().TickPool(
+		MeshPool,
+		UVoxelMeshComponent::StaticClass(),
+		GVoxelMeshComponentPoolSize,
+		!IsRunningDedicatedServer());
+}
 
-	if (!NewMesh)
-	{
-		NewMesh = ComponentSubsystem.CreateComponent<UVoxelMeshComponent>();
-		if (!ensure(NewMesh))
-		{
-			return nullptr;
-		}
-		
-		ComponentSubsystem.SetupSceneComponent(*NewMesh);
-
-		NewMesh->RegisterComponent();
-	}
-	
-	ComponentSubsystem.SetComponentPosition(*NewMesh, Position);
+UVoxelMeshComponent* FVoxelMeshComponentPool::CreateMesh(const FVector3d& Position)
+{
+	VOXEL_FUNCTION_COUNTER();
 
-	return NewMesh;
+	return CastChecked<UVoxelMeshComponent>(
+		GetSubsystem<FVoxelComponentSubsystem>().CreatePooledComponent(MeshPool, UVoxelMeshComponent::StaticClass(), Position),
+		ECastCheckedType::NullAllowed);
 }
 
 void FVoxelMeshComponentPool::DestroyMesh(UVoxelMeshComponent* Mesh)
 {
 	VOXEL_FUNCTION_COUNTER();
-	check(IsInGameThread());
 
 	if (!ensure(Mesh))
 	{
@@ -50,5 +45,5 @@ void FVoxelMeshComponentPool::DestroyMesh(UVoxelMeshComponent* Mesh)
 
 	Mesh->SetMesh({});
 
-	MeshPool.Add(Mesh);
+	GetSubsystem<FVoxelComponentSubsystem>().DestroyPooledComponent(MeshPool, Mesh);
 }
\ No newline at end of file
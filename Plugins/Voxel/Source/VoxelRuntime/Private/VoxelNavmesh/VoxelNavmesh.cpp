@@ -2,4 +2,308 @@
 
 #include "VoxelNavmesh/VoxelNavmesh.h"
 
-DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelNavigationMeshMemory);
\ No newline at end of file
+DEFINE_VOXEL_MEMORY_STAT(STAT_VoxelNavigationMeshMemory);
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, float, GVoxelNavmeshSimplifyTolerance, 0.9999f,
+	"voxel.navmesh.SimplifyTolerance",
+	"Min dot product between triangle normals for them to be considered coplanar when simplifying navmeshes");
+
+void FVoxelNavmesh::Simplify()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	TVoxelArray<FVector3f> NewVertices;
+	TVoxelArray<FIntVector> Triangles;
+	{
+		VOXEL_SCOPE_COUNTER("Weld");
+
+		TMap<FVector3f, int32> PositionToIndex;
+		PositionToIndex.Reserve(Vertices.Num());
+		NewVertices.Reserve(Vertices.Num());
+
+		TVoxelArray<int32> Remap;
+		FVoxelUtilities::SetNumFast(Remap, Vertices.Num());
+
+		for (int32 Index = 0; Index < Vertices.Num(); Index++)
+		{
+			int32& NewIndex = PositionToIndex.FindOrAdd(Vertices[Index], NewVertices.Num());
+			if (NewIndex == NewVertices.Num())
+			{
+				NewVertices.Add(Vertices[Index]);
+			}
+			Remap[Index] = NewIndex;
+		}
+
+		Triangles.Reserve(Indices.Num() / 3);
+		for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+		{
+			const FIntVector Triangle(Remap[Indices[Index + 0]], Remap[Indices[Index + 1]], Remap[Indices[Index + 2]]);
+			if (Triangle.X == Triangle.Y ||
+				Triangle.Y == Triangle.Z ||
+				Triangle.Z == Triangle.X)
+			{
+				continue;
+			}
+			Triangles.Add(Triangle);
+		}
+	}
+
+	const auto GetNormal = [&](const FIntVector& Triangle)
+	{
+		const FVector3f A = NewVertices[Triangle.X];
+		return FVector3f::CrossProduct(NewVertices[Triangle.Z] - A, NewVertices[Triangle.Y] - A).GetSafeNormal();
+	};
+
+	TArray<TArray<int32, TInlineAllocator<8>>> VertexTriangles;
+	VertexTriangles.SetNum(NewVertices.Num());
+	for (int32 TriangleIndex = 0; TriangleIndex < Triangles.Num(); TriangleIndex++)
+	{
+		const FIntVector& Triangle = Triangles[TriangleIndex];
+		VertexTriangles[Triangle.X].Add(TriangleIndex);
+		VertexTriangles[Triangle.Y].Add(TriangleIndex);
+		VertexTriangles[Triangle.Z].Add(TriangleIndex);
+	}
+
+	TBitArray<> ValidTriangles(true, Triangles.Num());
+
+	{
+		VOXEL_SCOPE_COUNTER("Collapse");
+
+		// Collapse vertices whose triangle fan is flat and closed into one of their neighbors
+		// Boundary vertices are never collapsed, so that chunks still match their neighbors
+		for (int32 Pass = 0; Pass < 8; Pass++)
+		{
+			bool bChanged = false;
+			TBitArray<> Touched(false, NewVertices.Num());
+
+			for (int32 Vertex = 0; Vertex < NewVertices.Num(); Vertex++)
+			{
+				const TArray<int32, TInlineAllocator<8>>& Fan = VertexTriangles[Vertex];
+				if (Touched[Vertex] ||
+					Fan.Num() < 3)
+				{
+					continue;
+				}
+
+				const FVector3f Normal = GetNormal(Triangles[Fan[0]]);
+				if (Normal.IsZero())
+				{
+					continue;
+				}
+
+				bool bIsFlat = true;
+				TArray<TPair<int32, int32>, TInlineAllocator<16>> NeighborCounts;
+				for (const int32 TriangleIndex : Fan)
+				{
+					const FIntVector& Triangle = Triangles[TriangleIndex];
+					if (FVector3f::DotProduct(GetNormal(Triangle), Normal) < GVoxelNavmeshSimplifyTolerance)
+					{
+						bIsFlat = false;
+						break;
+					}
+
+					for (int32 Corner = 0; Corner < 3; Corner++)
+					{
+						const int32 Neighbor = Triangle[Corner];
+						if (Neighbor == Vertex)
+						{
+							continue;
+						}
+
+						TPair<int32, int32>* Count = NeighborCounts.FindByPredicate([&](const TPair<int32, int32>& Pair) { return Pair.Key == Neighbor; });
+						if (!Count)
+						{
+							Count = &NeighborCounts.Emplace_GetRef(Neighbor, 0);
+						}
+						Count->Value++;
+					}
+				}
+
+				if (!bIsFlat ||
+					NeighborCounts.ContainsByPredicate([](const TPair<int32, int32>& Pair) { return Pair.Value != 2; }))
+				{
+					continue;
+				}
+
+				for (const TPair<int32, int32>& NeighborCount : NeighborCounts)
+				{
+					const int32 Target = NeighborCount.Key;
+
+					bool bIsValid = true;
+					for (const int32 TriangleIndex : Fan)
+					{
+						FIntVector Triangle = Triangles[TriangleIndex];
+						if (Triangle.X == Target ||
+							Triangle.Y == Target ||
+							Triangle.Z == Target)
+						{
+							continue;
+						}
+
+						for (int32 Corner = 0; Corner < 3; Corner++)
+						{
+							if (Triangle[Corner] == Vertex)
+							{
+								Triangle[Corner] = Target;
+							}
+						}
+
+						// Collapsed triangles must stay in the plane and not flip
+						if (FVector3f::DotProduct(GetNormal(Triangle), Normal) < GVoxelNavmeshSimplifyTolerance)
+						{
+							bIsValid = false;
+							break;
+						}
+					}
+
+					if (!bIsValid)
+					{
+						continue;
+					}
+
+					for (const int32 TriangleIndex : Fan)
+					{
+						FIntVector& Triangle = Triangles[TriangleIndex];
+						if (Triangle.X == Target ||
+							Triangle.Y == Target ||
+							Triangle.Z == Target)
+						{
+							ValidTriangles[TriangleIndex] = false;
+
+							for (int32 Corner = 0; Corner < 3; Corner++)
+							{
+								if (Triangle[Corner] != Vertex)
+								{
+									VertexTriangles[Triangle[Corner]].RemoveSwap(TriangleIndex);
+								}
+							}
+							continue;
+						}
+
+						for (int32 Corner = 0; Corner < 3; Corner++)
+						{
+							if (Triangle[Corner] == Vertex)
+							{
+								Triangle[Corner] = Target;
+							}
+						}
+						VertexTriangles[Target].Add(TriangleIndex);
+					}
+
+					for (const TPair<int32, int32>& Other : NeighborCounts)
+					{
+						Touched[Other.Key] = true;
+					}
+
+					VertexTriangles[Vertex].Reset();
+					bChanged = true;
+					break;
+				}
+			}
+
+			if (!bChanged)
+			{
+				break;
+			}
+		}
+	}
+
+	{
+		VOXEL_SCOPE_COUNTER("Compact");
+
+		TVoxelArray<int32> Remap;
+		Remap.SetNumUninitialized(NewVertices.Num());
+		FVoxelUtilities::SetAll(Remap, -1);
+
+		Indices.Reset();
+		Vertices.Reset();
+
+		for (int32 TriangleIndex = 0; TriangleIndex < Triangles.Num(); TriangleIndex++)
+		{
+			if (!ValidTriangles[TriangleIndex])
+			{
+				continue;
+			}
+
+			const FIntVector& Triangle = Triangles[TriangleIndex];
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				int32& Index = Remap[Triangle[Corner]];
+				if (Index == -1)
+				{
+					Index = Vertices.Add(NewVertices[Triangle[Corner]]);
+				}
+				Indices.Add(Index);
+			}
+		}
+	}
+}
+
+void FVoxelNavmesh::Finalize()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	FBox3f NewBounds(ForceInit);
+	ExportVertices.Reset(Vertices.Num());
+	for (const FVector3f& Vertex : Vertices)
+	{
+		NewBounds += Vertex;
+		ExportVertices.Add(FVector(Vertex));
+	}
+	Bounds = FBox(NewBounds);
+
+	Hash = CityHash64WithSeed(
+		reinterpret_cast<const char*>(Indices.GetData()),
+		Indices.Num() * Indices.GetTypeSize(),
+		CityHash64(reinterpret_cast<const char*>(Vertices.GetData()), Vertices.Num() * Vertices.GetTypeSize()));
+}
+
+TMap<FIntVector, TSharedPtr<const FVoxelNavmesh>> FVoxelNavmesh::SplitIntoCells(const float CellSize) const
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	struct FCell
+	{
+		TSharedPtr<FVoxelNavmesh> Navmesh;
+		TMap<int32, int32> Remap;
+	};
+	TMap<FIntVector, FCell> Cells;
+
+	for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+	{
+		const int32 Triangle[] = { Indices[Index + 0], Indices[Index + 1], Indices[Index + 2] };
+
+		FIntVector CellPosition = FIntVector::ZeroValue;
+		if (CellSize > 0.f)
+		{
+			const FVector3f Centroid = (Vertices[Triangle[0]] + Vertices[Triangle[1]] + Vertices[Triangle[2]]) / 3.f;
+			CellPosition = FVoxelUtilities::FloorToInt(Centroid / CellSize);
+		}
+
+		FCell& Cell = Cells.FindOrAdd(CellPosition);
+		if (!Cell.Navmesh)
+		{
+			Cell.Navmesh = MakeShared<FVoxelNavmesh>();
+		}
+
+		for (const int32 Vertex : Triangle)
+		{
+			int32& NewIndex = Cell.Remap.FindOrAdd(Vertex, Cell.Navmesh->Vertices.Num());
+			if (NewIndex == Cell.Navmesh->Vertices.Num())
+			{
+				Cell.Navmesh->Vertices.Add(Vertices[Vertex]);
+			}
+			Cell.Navmesh->Indices.Add(NewIndex);
+		}
+	}
+
+	TMap<FIntVector, TSharedPtr<const FVoxelNavmesh>> Result;
+	Result.Reserve(Cells.Num());
+	for (auto& It : Cells)
+	{
+		It.Value.Navmesh->Finalize();
+		Result.Add(It.Key, It.Value.Navmesh);
+	}
+	return Result;
+}
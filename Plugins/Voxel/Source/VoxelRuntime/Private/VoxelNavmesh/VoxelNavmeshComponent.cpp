@@ -15,6 +15,8 @@ void UVoxelNavmeshComponent::SetNavigationMesh(const TSharedPtr<const FVoxelNavm
 {
 	VOXEL_FUNCTION_COUNTER();
 
+	const FBox OldBounds = NavigationMesh ? Bounds.GetBox() : FBox(ForceInit);
+
 	NavigationMesh = NewNavigationMesh;
 
 	if (NavigationMesh)
@@ -22,6 +24,9 @@ void UVoxelNavmeshComponent::SetNavigationMesh(const TSharedPtr<const FVoxelNavm
 		NavigationMesh->UpdateStats();
 	}
 
+	// The navigation octree reads the component bounds
+	UpdateBounds();
+
 	if (IsRegistered() && 
 		GetWorld() && 
 		GetWorld()->GetNavigationSystem() && 
@@ -31,6 +36,14 @@ void UVoxelNavmeshComponent::SetNavigationMesh(const TSharedPtr<const FVoxelNavm
 
 		bNavigationRelevant = IsNavigationRelevant();
 		FNavigationSystem::UpdateComponentData(*this);
+
+		const FBox NewBounds = NavigationMesh ? Bounds.GetBox() : FBox(ForceInit);
+		const FBox DirtyArea = OldBounds + NewBounds;
+		if (DirtyArea.IsValid)
+		{
+			// Tiles the previous navmesh covered need to be rebuilt too
+			FNavigationSystem::OnComponentBoundsChanged(*this, NewBounds, DirtyArea);
+		}
 	}
 }
 
@@ -45,10 +58,15 @@ bool UVoxelNavmeshComponent::DoCustomNavigableGeometryExport(FNavigableGeometryE
 
 	if (NavigationMesh)
 	{
-		const TArray<FVector> DoubleVertices(NavigationMesh->Vertices);
+		// Navmeshes are finalized off the game thread, this is only a fallback
+		TArray<FVector> DoubleVertices;
+		if (!ensure(NavigationMesh->ExportVertices.Num() == NavigationMesh->Vertices.Num()))
+		{
+			DoubleVertices = TArray<FVector>(NavigationMesh->Vertices);
+		}
 
 		GeomExport.ExportCustomMesh(
-			DoubleVertices.GetData(),
+			DoubleVertices.Num() > 0 ? DoubleVertices.GetData() : NavigationMesh->ExportVertices.GetData(),
 			NavigationMesh->Vertices.Num(),
 			NavigationMesh->Indices.GetData(),
 			NavigationMesh->Indices.Num(),
@@ -1,34 +1,147 @@
 ﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
 
 #include "VoxelNavmesh/VoxelNavmeshProcessor.h"
+#include "VoxelNavmesh/VoxelNavmesh.h"
 #include "VoxelNavmesh/VoxelNavmeshComponent.h"
 #include "VoxelNavmesh/VoxelNavmeshComponentPool.h"
 
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, float, GVoxelNavmeshCellSize, 1600.f,
+	"voxel.navmesh.CellSize",
+	"Navmeshes are split into cells of this size, so that an edit only dirties the navigation tiles of the cells it changed. 0 to disable");
+
+VOXEL_CONSOLE_VARIABLE(
+	VOXELRUNTIME_API, bool, GVoxelNavmeshSimplify, true,
+	"voxel.navmesh.Simplify",
+	"If true, coplanar triangles of navmeshes will be merged before being sent to the navigation system");
+
 DEFINE_UNIQUE_VOXEL_ID(FVoxelNavmeshProcessorId);
 DEFINE_VOXEL_SUBSYSTEM(FVoxelNavmeshProcessor);
 
+TMap<FIntVector, TSharedPtr<const FVoxelNavmesh>> FVoxelNavmeshProcessor::PrepareNavmesh(const FVoxelNavmesh& Navmesh)
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	if (!GVoxelNavmeshSimplify)
+	{
+		return Navmesh.SplitIntoCells(GVoxelNavmeshCellSize);
+	}
+
+	FVoxelNavmesh SimplifiedNavmesh;
+	SimplifiedNavmesh.Indices = Navmesh.Indices;
+	SimplifiedNavmesh.Vertices = Navmesh.Vertices;
+	SimplifiedNavmesh.Simplify();
+
+	return SimplifiedNavmesh.SplitIntoCells(GVoxelNavmeshCellSize);
+}
+
 FVoxelNavmeshProcessorId FVoxelNavmeshProcessor::CreateNavmesh(
-	const FVector3d& Position,
-	const TSharedRef<const FVoxelNavmesh>& NavigationMesh)
+	const FVoxelBox& Bounds,
+	const TMap<FIntVector, TSharedPtr<const FVoxelNavmesh>>& Cells)
 {
+	VOXEL_FUNCTION_COUNTER();
+
 	const FVoxelNavmeshProcessorId Id = FVoxelNavmeshProcessorId::New();
 
-	TWeakObjectPtr<UVoxelNavmeshComponent>& Component = Components.Add(Id);
-	Component = GetSubsystem<FVoxelNavmeshComponentPool>().CreateComponent(Position);
-	Component->SetNavigationMesh(NavigationMesh);
+	TSharedPtr<FChunk>& Chunk = Chunks.FindOrAdd(Bounds);
+	if (!Chunk)
+	{
+		Chunk = MakeShared<FChunk>();
+	}
+	else
+	{
+		// Take over the previous navmesh with the same bounds: its own DestroyNavmesh will be a no-op
+		IdToBounds.Remove(Chunk->Id);
+	}
+
+	Chunk->Id = Id;
+	Chunk->bPendingDestroy = false;
+	IdToBounds.Add(Id, Bounds);
+
+	for (auto It = Chunk->Cells.CreateIterator(); It; ++It)
+	{
+		if (!Cells.Contains(It.Key()))
+		{
+			DestroyCell(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const auto& It : Cells)
+	{
+		FCell& Cell = Chunk->Cells.FindOrAdd(It.Key);
+		if (Cell.Component.IsValid() &&
+			Cell.Hash == It.Value->Hash)
+		{
+			continue;
+		}
+
+		if (!Cell.Component.IsValid())
+		{
+			Cell.Component = GetSubsystem<FVoxelNavmeshComponentPool>().CreateComponent(Bounds.Min);
+		}
+
+		if (ensure(Cell.Component.IsValid()))
+		{
+			Cell.Hash = It.Value->Hash;
+			Cell.Component->SetNavigationMesh(It.Value);
+		}
+	}
 
 	return Id;
 }
 
 void FVoxelNavmeshProcessor::DestroyNavmesh(FVoxelNavmeshProcessorId Id)
 {
-	TWeakObjectPtr<UVoxelNavmeshComponent> Component;
+	FVoxelBox Bounds;
 	if (IsDestroyed() ||
-		!ensure(Components.RemoveAndCopyValue(Id, Component)) ||
-		!Component.IsValid())
+		!IdToBounds.RemoveAndCopyValue(Id, Bounds))
+	{
+		return;
+	}
+
+	const TSharedPtr<FChunk> Chunk = Chunks.FindRef(Bounds);
+	if (!ensure(Chunk) ||
+		!ensure(Chunk->Id == Id))
+	{
+		return;
+	}
+
+	// Delay the destruction to the next tick in case the chunk is recreated with the same bounds
+	Chunk->bPendingDestroy = true;
+	PendingDestroys.Add(Bounds);
+}
+
+void FVoxelNavmeshProcessor::Tick()
+{
+	VOXEL_FUNCTION_COUNTER();
+
+	Super::Tick();
+
+	for (const FVoxelBox& Bounds : PendingDestroys)
+	{
+		const TSharedPtr<FChunk> Chunk = Chunks.FindRef(Bounds);
+		if (!Chunk ||
+			!Chunk->bPendingDestroy)
+		{
+			continue;
+		}
+
+		for (const auto& It : Chunk->Cells)
+		{
+			DestroyCell(It.Value);
+		}
+		Chunks.Remove(Bounds);
+	}
+	PendingDestroys.Reset();
+}
+
+void FVoxelNavmeshProcessor::DestroyCell(const FCell& Cell)
+{
+	if (!Cell.Component.IsValid())
 	{
 		return;
 	}
 
-	GetSubsystem<FVoxelNavmeshComponentPool>().DestroyComponent(Component.Get());
-}
\ No newline at end of file
+	GetSubsystem<FVoxelNavmeshComponentPool>().DestroyComponent(Cell.Component.Get());
+}
@@ -7,6 +7,7 @@
 #include "VoxelCollisionComponent.generated.h"
 
 struct FVoxelCollider;
+struct FVoxelHeightfieldCollider;
 
 UCLASS()
 class VOXELRUNTIME_API UVoxelCollisionComponent final : public UPrimitiveComponent
@@ -21,6 +22,8 @@ public:
 	//~ Begin UPrimitiveComponent Interface.
 	virtual UBodySetup* GetBodySetup() override { return BodySetup; }
 	virtual bool ShouldCreatePhysicsState() const override;
+	virtual void OnCreatePhysicsState() override;
+	virtual void OnDestroyPhysicsState() override;
 	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
 	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
@@ -29,6 +32,8 @@ public:
 	//~ End UPrimitiveComponent Interface.
 	
 private:
+	void CreateHeightfieldPhysicsState(const FVoxelHeightfieldCollider& HeightfieldCollider);
+
 	UPROPERTY(Transient)
 	TObjectPtr<UBodySetup> BodySetup;
 
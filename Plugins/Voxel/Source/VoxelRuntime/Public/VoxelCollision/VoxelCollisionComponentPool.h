@@ -4,6 +4,7 @@
 
 #include "VoxelMinimal.h"
 #include "VoxelRuntime/VoxelSubsystem.h"
+#include "VoxelComponentSubsystem.h"
 #include "VoxelCollisionComponentPool.generated.h"
 
 class UVoxelCollisionComponent;
@@ -20,9 +21,13 @@ class VOXELRUNTIME_API FVoxelCollisionComponentPool : public IVoxelSubsystem
 public:
 	GENERATED_VOXEL_SUBSYSTEM_BODY(UVoxelCollisionComponentPoolProxy);
 
+	//~ Begin IVoxelSubsystem Interface
+	virtual void Tick() override;
+	//~ End IVoxelSubsystem Interface
+
 	UVoxelCollisionComponent* CreateComponent(const FVector3d& Position);
 	void DestroyComponent(UVoxelCollisionComponent* Mesh);
 
 private:
-	TArray<TWeakObjectPtr<UVoxelCollisionComponent>> MeshPool;
+	FVoxelComponentSubsystem::FComponentPool MeshPool;
 };
\ No newline at end of file
@@ -4,12 +4,50 @@
 
 #include "VoxelMinimal.h"
 
+struct FVoxelCollider;
+struct FVoxelHeightfieldCollider;
 struct FVoxelTriangleMeshCollider;
 
+// Positions collision cooks are prioritized around, in the same space as the bounds of the cooks
+class VOXELRUNTIME_API FVoxelCollisionCookPriority
+{
+public:
+	void SetPositions(TArray<FVector>&& NewPositions);
+	double GetSquaredDistance(const FBox& Bounds) const;
+
+private:
+	mutable FVoxelCriticalSection CriticalSection;
+	TArray<FVector> Positions;
+};
+
 struct VOXELRUNTIME_API FVoxelCollisionCooker
 {
+	// Cooked triangle meshes are cached by a hash of their inputs, so identical chunks reuse the previous cook
 	static TSharedPtr<FVoxelTriangleMeshCollider> CookTriangleMesh(
 		TConstVoxelArrayView<int32> Indices,
 		TConstVoxelArrayView<FVector3f> Vertices,
 		TConstVoxelArrayView<uint16> FaceMaterials);
+
+	// Samples the mesh on a grid of CellSize, triangles are expected to be wound like voxel surfaces
+	// Cooked heightfields are cached the same way as triangle meshes
+	// Returns null if the mesh isn't single-valued in Z, ie if it has overhangs, vertical faces or holes
+	static TSharedPtr<FVoxelHeightfieldCollider> CookHeightfield(
+		TConstVoxelArrayView<int32> Indices,
+		TConstVoxelArrayView<FVector3f> Vertices,
+		TConstVoxelArrayView<uint16> FaceMaterials,
+		float CellSize);
+
+	// Queues a cook on the collision cooking threads
+	// Cooks closest to the priority positions run first, and small cooks are batched together
+	// If HeightfieldCellSize is positive, meshes without overhangs are cooked as heightfields
+	// OnComplete is called on a background thread, with null if Priority was destroyed before the cook started
+	static void CookMeshAsync(
+		const FBox& Bounds,
+		const TSharedRef<const FVoxelCollisionCookPriority>& Priority,
+		TVoxelArray<int32>&& Indices,
+		TVoxelArray<FVector3f>&& Vertices,
+		TVoxelArray<uint16>&& FaceMaterials,
+		TArray<TWeakObjectPtr<UPhysicalMaterial>>&& PhysicalMaterials,
+		float HeightfieldCellSize,
+		TFunction<void(const TSharedPtr<FVoxelCollider>&)>&& OnComplete);
 };
\ No newline at end of file
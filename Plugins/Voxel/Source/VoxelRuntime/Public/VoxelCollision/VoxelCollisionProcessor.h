@@ -4,10 +4,12 @@
 
 #include "VoxelMinimal.h"
 #include "VoxelRuntime/VoxelSubsystem.h"
+#include "VoxelCollision/VoxelCollisionCooker.h"
 #include "VoxelCollisionProcessor.generated.h"
 
 struct FVoxelCollider;
 class UVoxelCollisionComponent;
+class FVoxelCollisionCookPriority;
 
 DECLARE_UNIQUE_VOXEL_ID(FVoxelCollisionProcessorId);
 
@@ -23,6 +25,14 @@ class VOXELRUNTIME_API FVoxelCollisionProcessor : public IVoxelSubsystem
 public:
 	GENERATED_VOXEL_SUBSYSTEM_BODY(UVoxelCollisionProcessorProxy);
 
+	//~ Begin IVoxelSubsystem Interface
+	virtual void Tick() override;
+	//~ End IVoxelSubsystem Interface
+
+	// Cooks are prioritized around the camera and pawns, in runtime local space
+	// Thread safe
+	const TSharedRef<FVoxelCollisionCookPriority> CookPriority = MakeShared<FVoxelCollisionCookPriority>();
+
 	FVoxelCollisionProcessorId CreateCollision(
 		const FVector3d& Position,
 		const FBodyInstance& BodyInstance,
@@ -0,0 +1,29 @@
+﻿// Copyright Voxel Plugin, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "VoxelMinimal.h"
+#include "VoxelCollision/VoxelCollider.h"
+#include "Chaos/HeightField.h"
+#include "VoxelHeightfieldCollider.generated.h"
+
+// Cheaper alternative to triangle meshes for surfaces without overhangs
+// Heightfields can't be added to body setups, UVoxelCollisionComponent creates their physics actor itself
+USTRUCT()
+struct VOXELRUNTIME_API FVoxelHeightfieldCollider : public FVoxelCollider
+{
+	GENERATED_BODY()
+	GENERATED_VIRTUAL_STRUCT_BODY()
+
+	FBox Bounds = FBox(ForceInit);
+	// Position of the first heightfield sample, relative to the component
+	FVector Offset = FVector::ZeroVector;
+	TSharedPtr<Chaos::FHeightField> Heightfield;
+	TArray<TWeakObjectPtr<UPhysicalMaterial>> PhysicalMaterials;
+
+	virtual FBox GetBounds() const override { return Bounds; }
+	virtual int64 GetAllocatedSize() const override;
+	virtual void AddToBodySetup(UBodySetup& BodySetup) const override {}
+	virtual TSharedPtr<IVoxelColliderRenderData> GetRenderData() const override;
+	virtual TArray<TWeakObjectPtr<UPhysicalMaterial>> GetPhysicalMaterials() const override;
+};
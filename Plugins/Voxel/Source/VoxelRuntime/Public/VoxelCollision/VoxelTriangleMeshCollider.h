@@ -28,6 +28,8 @@ class VOXELRUNTIME_API FVoxelTriangleMeshCollider_RenderData : public IVoxelColl
 {
 public:
 	explicit FVoxelTriangleMeshCollider_RenderData(const FVoxelTriangleMeshCollider& Collider);
+	// Vertices are a triangle list
+	explicit FVoxelTriangleMeshCollider_RenderData(TVoxelArray<FVector3f>&& Vertices);
 	virtual ~FVoxelTriangleMeshCollider_RenderData() override;
 
 	//~ Begin IVoxelColliderRenderData Interface
@@ -35,6 +37,8 @@ public:
 	//~ End IVoxelColliderRenderData Interface
 
 private:
+	void Initialize(const TVoxelArray<FVector3f>& Vertices);
+
 	FRawStaticIndexBuffer IndexBuffer{ false };
 	FPositionVertexBuffer PositionVertexBuffer;
 	FStaticMeshVertexBuffer StaticMeshVertexBuffer;
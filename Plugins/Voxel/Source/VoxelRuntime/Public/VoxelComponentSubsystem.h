@@ -6,6 +6,9 @@
 #include "VoxelRuntime/VoxelSubsystem.h"
 #include "VoxelComponentSubsystem.generated.h"
 
+extern VOXELRUNTIME_API float GVoxelComponentPoolBudget;
+extern VOXELRUNTIME_API float GVoxelComponentPoolShrinkDelay;
+
 UCLASS()
 class VOXELRUNTIME_API UVoxelComponentSubsystemProxy : public UVoxelSubsystemProxy
 {
@@ -29,6 +32,23 @@ public:
 
 	void SetupSceneComponent(USceneComponent& Component) const;
 	void SetComponentPosition(USceneComponent& Component, const FVector3d& Position) const;
+
+	// Registered components kept ready to be reused, see the mesh & collision component pools
+	struct FComponentPool
+	{
+		TArray<TWeakObjectPtr<USceneComponent>> Components;
+
+		int32 NumInUse = 0;
+		int32 PeakDemand = 0;
+		double PeakDemandResetTime = 0.;
+	};
+
+	// Shrinks the pool down to its target size, or fills it up within GVoxelComponentPoolBudget
+	// If bPrewarm is false, the target size is 0 and components are only created on demand
+	void TickPool(FComponentPool& Pool, const UClass* Class, int32 PoolSize, bool bPrewarm);
+	USceneComponent* CreatePooledComponent(FComponentPool& Pool, const UClass* Class, const FVector3d& Position);
+	// The component is expected to have released its data already
+	void DestroyPooledComponent(FComponentPool& Pool, USceneComponent* Component);
 	
 	template<typename T, typename = typename TEnableIf<TIsDerivedFrom<T, UActorComponent>::Value>::Type>
 	T* CreateComponent(UClass* Class = nullptr)
@@ -42,4 +62,6 @@ public:
 
 private:
 	TSet<FObjectKey> Components;
+
+	USceneComponent* CreateNewPooledComponent(const UClass* Class);
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "VoxelMinimal.h"
 #include "VoxelRuntime/VoxelSubsystem.h"
+#include "VoxelComponentSubsystem.h"
 #include "VoxelMeshComponentPool.generated.h"
 
 class UVoxelMeshComponent;
@@ -19,10 +20,14 @@ class VOXELRUNTIME_API FVoxelMeshComponentPool : public IVoxelSubsystem
 {
 public:
 	GENERATED_VOXEL_SUBSYSTEM_BODY(UVoxelMeshComponentPoolProxy);
-	
+
+	//~ Begin IVoxelSubsystem Interface
+	virtual void Tick() override;
+	//~ End IVoxelSubsystem Interface
+
 	UVoxelMeshComponent* CreateMesh(const FVector3d& Position);
 	void DestroyMesh(UVoxelMeshComponent* Mesh);
 
 private:
-	TArray<TWeakObjectPtr<UVoxelMeshComponent>> MeshPool;
+	FVoxelComponentSubsystem::FComponentPool MeshPool;
 };
\ No newline at end of file
@@ -16,10 +16,24 @@ struct VOXELRUNTIME_API FVoxelNavmesh
 	TVoxelArray<int32> Indices;
 	TVoxelArray<FVector3f> Vertices;
 
+	// Set by Finalize
+	// Vertices in the format expected by FNavigableGeometryExport, to not convert them on every export
+	TVoxelArray<FVector> ExportVertices;
+	uint64 Hash = 0;
+
 	VOXEL_ALLOCATED_SIZE_TRACKER(STAT_VoxelNavigationMeshMemory);
 
 	int64 GetAllocatedSize() const
 	{
-		return Indices.GetAllocatedSize() + Vertices.GetAllocatedSize();
+		return Indices.GetAllocatedSize() + Vertices.GetAllocatedSize() + ExportVertices.GetAllocatedSize();
 	}
+
+public:
+	// Welds vertices and collapses vertices inside flat areas
+	void Simplify();
+	void Finalize();
+
+	// Splits the triangles by cell of size CellSize, using their centroid
+	// Returned navmeshes are finalized
+	TMap<FIntVector, TSharedPtr<const FVoxelNavmesh>> SplitIntoCells(float CellSize) const;
 };
\ No newline at end of file
@@ -23,12 +23,39 @@ class VOXELRUNTIME_API FVoxelNavmeshProcessor : public IVoxelSubsystem
 public:
 	GENERATED_VOXEL_SUBSYSTEM_BODY(UVoxelNavmeshProcessorProxy);
 
+	// Simplifies the navmesh and splits it into cells, to be called from a background thread
+	static TMap<FIntVector, TSharedPtr<const FVoxelNavmesh>> PrepareNavmesh(const FVoxelNavmesh& Navmesh);
+
+	// Cells must come from PrepareNavmesh
+	// A navmesh created with the same bounds as an existing one takes it over
 	FVoxelNavmeshProcessorId CreateNavmesh(
-		const FVector3d& Position,
-		const TSharedRef<const FVoxelNavmesh>& Navmesh);
+		const FVoxelBox& Bounds,
+		const TMap<FIntVector, TSharedPtr<const FVoxelNavmesh>>& Cells);
 
 	void DestroyNavmesh(FVoxelNavmeshProcessorId Id);
 
+	//~ Begin IVoxelSubsystem Interface
+	virtual void Tick() override;
+	//~ End IVoxelSubsystem Interface
+
 private:
-	TMap<FVoxelNavmeshProcessorId, TWeakObjectPtr<UVoxelNavmeshComponent>> Components;
+	struct FCell
+	{
+		uint64 Hash = 0;
+		TWeakObjectPtr<UVoxelNavmeshComponent> Component;
+	};
+	// A chunk rebuilt with the same bounds reuses the components of its previous navmesh,
+	// so that only the cells that changed are updated in the navigation system
+	struct FChunk
+	{
+		FVoxelNavmeshProcessorId Id;
+		bool bPendingDestroy = false;
+		TMap<FIntVector, FCell> Cells;
+	};
+
+	TMap<FVoxelBox, TSharedPtr<FChunk>> Chunks;
+	TMap<FVoxelNavmeshProcessorId, FVoxelBox> IdToBounds;
+	TArray<FVoxelBox> PendingDestroys;
+
+	void DestroyCell(const FCell& Cell);
 };
\ No newline at end of file